@@ -0,0 +1,49 @@
+#include <cstdio> // printf()
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring> // strstr()
+
+#include "Benchmark.hpp" // Benchmark{}
+#include "helper.hpp" // TR
+
+///
+/// Standalone CPU benchmarks (`make bench`), built optimised:
+///
+///   benchmark [filter]
+///
+/// Only benchmarks whose name contains `filter` run.
+///
+
+TR_BEGIN_NAMESPACE()
+
+// Constant-initialised, before any benchmark registers itself.
+static constinit Benchmark* s_benchmarks = NULL;
+
+Benchmark::Benchmark(char const* name, bool (*function)(void)) NOEXCEPT
+  : name(name), function(function), next(s_benchmarks)
+{
+  s_benchmarks = this;
+}
+
+Benchmark* Benchmarks(void) NOEXCEPT {
+  return s_benchmarks;
+}
+
+TR_END_NAMESPACE()
+
+int main(int argc, char* argv[]) {
+  char const* filter = argc > 1 ? argv[1] : "";
+  printf("Median of %u runs\n", TR_BENCH_REPETITIONS);
+
+  bool success = true;
+  for (TR::Benchmark* benchmark = TR::Benchmarks(); benchmark != NULL; benchmark = benchmark->next) {
+    if (strstr(benchmark->name, filter) == NULL) continue;
+
+    printf("\n[%s]\n", benchmark->name);
+    if (!benchmark->function()) {
+      printf("[%s] FAILED\n", benchmark->name);
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
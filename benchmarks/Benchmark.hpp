@@ -0,0 +1,93 @@
+#ifndef TR_BENCHMARK_HPP
+#define TR_BENCHMARK_HPP
+
+#include <algorithm> // std::sort()
+#include <chrono> // std::chrono::steady_clock{}
+#include <cmath> // sqrt()
+#include <cstddef> // size_t
+#include <cstdio> // printf()
+#include <vector> // std::vector{}
+
+#include "helper.hpp" // NOEXCEPT
+
+#define TR_BENCH_REPETITIONS 31u
+
+TR_BEGIN_NAMESPACE()
+
+/// Nanoseconds per operation over the repetitions.
+struct BenchmarkStats {
+  double median, min, max, deviation;
+};
+
+///
+/// Benchmarks link themselves at static initialisation (see
+/// `TR_BENCHMARK()`), `main()` runs them: no GL context is created.
+///
+struct Benchmark {
+  char const* name;
+  bool (*function)(void); // False when the results are wrong
+  Benchmark* next;
+
+  Benchmark(char const* name, bool (*function)(void)) NOEXCEPT;
+};
+
+/// First registered benchmark (then follow `next`).
+Benchmark* Benchmarks(void) NOEXCEPT;
+
+#define TR_BENCHMARK(NAME)                                           \
+  static bool NAME##Benchmark(void);                                  \
+  static TR::Benchmark s_##NAME##Benchmark(#NAME, &NAME##Benchmark);  \
+  static bool NAME##Benchmark(void)
+
+/// Keep the compiler from optimising the results away.
+inline void Escape(void const* pointer) NOEXCEPT {
+  asm volatile("" : : "g"(pointer) : "memory");
+}
+
+///
+/// Time `function` (performing `operations` operations) once for warm-up
+/// then `TR_BENCH_REPETITIONS` times, `setup` runs untimed before each run.
+///
+template <typename Setup, typename Function>
+BenchmarkStats Measure(char const* name, size_t operations, Setup&& setup, Function&& function) NOEXCEPT {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> samples;
+  setup(); function();
+
+  for (unsigned int run = 0u; run < TR_BENCH_REPETITIONS; ++run) {
+    setup();
+    Clock::time_point start = Clock::now();
+    function();
+    Clock::time_point end = Clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    samples.push_back(ns / static_cast<double>(operations));
+  }
+
+  double mean = 0.0, variance = 0.0;
+  for (double sample: samples) mean += sample;
+  mean /= static_cast<double>(samples.size());
+  for (double sample: samples) variance += (sample - mean) * (sample - mean);
+  variance /= static_cast<double>(samples.size() - 1u);
+
+  std::sort(samples.begin(), samples.end());
+  BenchmarkStats stats = {
+    .median = samples[samples.size() / 2u],
+    .min = samples.front(),
+    .max = samples.back(),
+    .deviation = sqrt(variance),
+  };
+
+  printf("%-32s %10.2f ns/op (min %.2f, max %.2f, stddev %.2f)\n",
+    name, stats.median, stats.min, stats.max, stats.deviation
+  );
+  return stats;
+}
+
+template <typename Function>
+BenchmarkStats Measure(char const* name, size_t operations, Function&& function) NOEXCEPT {
+  return Measure(name, operations, [] {}, function);
+}
+
+TR_END_NAMESPACE()
+
+#endif // TR_BENCHMARK_HPP
@@ -0,0 +1,31 @@
+#include <glm/mat4x4.hpp> // glm::mat4{}
+
+#include "Benchmark.hpp" // TR_BENCHMARK(), Measure(), Escape()
+#include "Camera.hpp" // Camera{}
+#include "helper.hpp" // TR
+
+#define TR_BENCH_UPDATES 10000u
+
+/// `Camera::LookAt()` and `Projection()`, rebuilt or read from the cache.
+TR_BENCHMARK(Camera) {
+  TR::Camera camera;
+  int width = 1280;
+
+  // Resizing invalidates the camera, the next read rebuilds every matrix.
+  TR::Measure("Camera LookAt+Projection", TR_BENCH_UPDATES, [&]() {
+    for (unsigned int i = 0u; i < TR_BENCH_UPDATES; ++i) {
+      camera.SetDimensions(width ^= 1, 720);
+      TR::Escape(&camera.LookAt());
+      TR::Escape(&camera.Projection());
+    }
+  });
+
+  TR::Measure("Camera ViewProjection cached", TR_BENCH_UPDATES, [&]() {
+    for (unsigned int i = 0u; i < TR_BENCH_UPDATES; ++i) {
+      TR::Escape(&camera.ViewProjection());
+    }
+  });
+
+  glm::mat4 const& projection = camera.Projection();
+  return projection[3][2] != 0.0f; // Perspective
+}
@@ -0,0 +1,42 @@
+#include "Benchmark.hpp" // TR_BENCHMARK(), Measure()
+#include "Log.hpp" // TR_INFO(), GlobalLogFlush(), GlobalLogConsole()
+#include "helper.hpp" // TR
+
+// Below the ring capacity: nothing is dropped between two flushes.
+#define TR_BENCH_MESSAGES 1000u
+static_assert(TR_BENCH_MESSAGES < TR_LOG_CAPACITY);
+
+TR_BEGIN_NAMESPACE()
+
+/// `GlobalLog()` as seen by the caller, then up to the window storage.
+TR_BENCHMARK(Log) {
+  GlobalLogConsole(false); // The terminal would dominate.
+  size_t dropped = GlobalLogDropped();
+
+  Measure("TR_INFO enqueue", TR_BENCH_MESSAGES, GlobalLogFlush, [&]() {
+    for (unsigned int i = 0u; i < TR_BENCH_MESSAGES; ++i) {
+      TR_INFO("Benchmark message %u of %s", i, "a string argument");
+    }
+  });
+
+  Measure("TR_INFO enqueue+format", TR_BENCH_MESSAGES, [&]() {
+    for (unsigned int i = 0u; i < TR_BENCH_MESSAGES; ++i) {
+      TR_INFO("Benchmark message %u of %s", i, "a string argument");
+    }
+    GlobalLogFlush();
+  });
+
+  // Filtered out by the module threshold: one load and one branch.
+  s_logModule.level.store(LogLevel::WARNING, std::memory_order_relaxed);
+  Measure("TR_INFO filtered", TR_BENCH_MESSAGES, [&]() {
+    for (unsigned int i = 0u; i < TR_BENCH_MESSAGES; ++i) {
+      TR_INFO("Benchmark message %u of %s", i, "a string argument");
+    }
+  });
+  s_logModule.level.store(static_cast<LogLevel>(TR_LOG_LEVEL), std::memory_order_relaxed);
+
+  GlobalLogConsole(true);
+  return GlobalLogDropped() == dropped;
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,52 @@
+#include <stb/stb_image.h> // stbi_load_from_memory()
+
+#include <cstdio> // printf(), snprintf(), fopen(), fread()
+#include <string> // std::string{}
+#include <vector> // std::vector{}
+
+#include "Benchmark.hpp" // TR_BENCHMARK(), Measure(), Escape()
+#include "helper.hpp" // TR_ARRAYSIZE()
+
+static bool ReadFile(std::string const& path, std::vector<unsigned char>& data) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == NULL) return false;
+
+  unsigned char buffer[1 << 16];
+  for (size_t size; (size = fread(buffer, 1u, sizeof(buffer), file)) > 0u;) {
+    data.insert(data.end(), buffer, buffer + size);
+  }
+  fclose(file);
+  return !data.empty();
+}
+
+/// Decode of `resources/textures`, as done by the `TextureLoader` workers
+/// (from memory: the disk is left out).
+TR_BENCHMARK(TextureDecode) {
+  static char const* const filenames[] = { "container.jpg", "wall.jpg", "awesomeface.png" };
+  stbi_set_flip_vertically_on_load(true);
+  bool success = true;
+
+  for (size_t i = 0u; i < TR_ARRAYSIZE(filenames); ++i) {
+    std::vector<unsigned char> data;
+    if (!ReadFile(std::string(TR_RESOURCES_DIR "/textures/") + filenames[i], data)) {
+      printf("%-32s missing\n", filenames[i]);
+      success = false;
+      continue;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    char name[64];
+    snprintf(name, sizeof(name), "stbi decode %s", filenames[i]);
+    TR::BenchmarkStats stats = TR::Measure(name, 1u, [&]() {
+      unsigned char* pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, &channels, 0);
+      TR::Escape(pixels);
+      stbi_image_free(pixels);
+    });
+
+    double bytes = static_cast<double>(width) * height * channels;
+    printf("%-32s %10.1f MB/s (%dx%d, %d channels)\n", "", bytes / stats.median * 1e3, width, height, channels);
+    success = success && width > 0;
+  }
+
+  return success;
+}
@@ -0,0 +1,69 @@
+#include <glm/gtc/matrix_transform.hpp> // glm::translate(), glm::rotate()
+#include <glm/mat4x4.hpp> // glm::mat4{}
+
+#include <cmath> // fabsf()
+#include <cstdio> // printf()
+#include <random> // std::mt19937{}
+#include <vector> // std::vector{}
+
+#include "Benchmark.hpp" // TR_BENCHMARK(), Measure(), Escape()
+#include "Transform.hpp" // BuildModelMatrices()
+#include "helper.hpp" // TR
+
+#define TR_BENCH_OBJECTS 100000u
+
+/// Model matrices of every object, as `Engine::Update()` builds them.
+TR_BENCHMARK(Transform) {
+  TR::TransformArrays objects;
+  std::mt19937 random(42u);
+  std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> angle(-10.0f, 10.0f);
+
+  for (unsigned int i = 0u; i < TR_BENCH_OBJECTS; ++i) {
+    glm::vec3 axis(position(random), position(random), position(random));
+    objects.Push({ position(random), position(random), position(random) }, axis, angle(random), 1.0f);
+  }
+
+  std::vector<glm::mat4> reference(TR_BENCH_OBJECTS), models(TR_BENCH_OBJECTS);
+  TR::TransformStreams streams = objects.Streams();
+
+  printf("%u objects\n", TR_BENCH_OBJECTS);
+
+  // What Engine::Render used to do for every object.
+  double baseline = TR::Measure("glm translate+rotate", TR_BENCH_OBJECTS, [&]() {
+    for (size_t i = 0u; i < streams.count; ++i) {
+      glm::mat4 model = glm::mat4(1.0f);
+      model = glm::translate(model, glm::vec3(streams.x[i], streams.y[i], streams.z[i]));
+      model = glm::rotate(model, streams.angle[i], glm::vec3(streams.axisX[i], streams.axisY[i], streams.axisZ[i]));
+      reference[i] = model;
+    }
+    TR::Escape(reference.data());
+  }).median;
+
+  bool success = true;
+  TR::TransformKernel kernels[] = { TR::TransformKernel::Scalar, TR::TransformKernel::SSE, TR::TransformKernel::AVX2 };
+  for (TR::TransformKernel kernel: kernels) {
+    if (kernel > TR::TransformKernelDetect()) continue;
+
+    char name[64];
+    snprintf(name, sizeof(name), "BuildModelMatrices %s", TR::TransformKernelName(kernel));
+    double median = TR::Measure(name, TR_BENCH_OBJECTS, [&]() {
+      TR::BuildModelMatrices(streams, models.data(), kernel);
+      TR::Escape(models.data());
+    }).median;
+
+    float error = 0.0f;
+    for (size_t i = 0u; i < streams.count; ++i) {
+      for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+          error = TR_MAX(error, fabsf(models[i][column][row] - reference[i][column][row]));
+        }
+      }
+    }
+
+    printf("%-32s %10.2fx speed-up, max error %.2e\n", "", baseline / median, static_cast<double>(error));
+    success = success && error < 1e-4f;
+  }
+
+  return success;
+}
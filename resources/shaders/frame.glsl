@@ -0,0 +1,10 @@
+// Per-frame constants, shared by every program (see FrameConstants.hpp).
+layout (std140) uniform tr_Frame {
+  mat4 tr_view;
+  mat4 tr_projection;
+  mat4 tr_viewProjection;
+  mat4 tr_inverseView;
+  vec3 tr_camera;
+  float tr_near;
+  float tr_far;
+};
@@ -6,19 +6,6 @@
 // https://developer.nvidia.com/gpugems/gpugems2/part-iii-high-quality-rendering/chapter-22-fast-prefiltered-lines
 // https://fr.wikipedia.org/wiki/Segment_circulaire
 
-#define GRID_NONE 0x0u
-#define SHOW_GRID 0x1u
-
-#define GRID_AXIS_X    0x010u
-#define GRID_AXIS_Y    0x020u
-#define GRID_AXIS_Z    0x040u
-#define GRID_AXIS_MASK 0x070u
-
-#define GRID_PLANE_XY   0x100u
-#define GRID_PLANE_YZ   0x200u
-#define GRID_PLANE_XZ   0x400u
-#define GRID_PLANE_MASK 0x700u
-
 #define GRID_STEPS 8
 const float gridSteps[GRID_STEPS] = float[GRID_STEPS](
   0.001f, 0.01f, 0.1f, 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f
@@ -27,11 +14,9 @@ const float gridSteps[GRID_STEPS] = float[GRID_STEPS](
 in vec3 tr_position;
 out vec4 tr_fragment;
 
-uniform mat4 tr_view;
-uniform uint tr_flags;
-uniform vec3 tr_camera;
+#include "frame.glsl"
+#include "grid.glsl"
 
-uniform float tr_near, tr_far;
 uniform float tr_lineSize = 1.0; // TODO: DPI
 
 uniform vec4 tr_colorGrid;
@@ -103,13 +88,6 @@ vec3 getAxes(vec3 position, vec3 fwidthPosition, float lineSize) {
   return GRID_LINE_STEP(axesDomain - (lineSize + tr_lineSize));
 }
 
-///
-/// Test if a flag (or a mask) validates the given value.
-///
-/// (To test an exact match replace `!= 0u` with `== (FLAGS)`).
-///
-#define testFlag(VALUE, FLAGS) (((VALUE) & (FLAGS)) != 0u)
-
 ///
 /// Linear step in [0.0, 1.0] of VALUE from MIN to MAX.
 ///
@@ -151,11 +129,10 @@ void main(void) {
   fade *= 1.0 - smoothstep(0.0, tr_far / 2, localDistance - tr_far / 2);
 
   if (testFlag(tr_flags, SHOW_GRID) && testFlag(tr_flags, GRID_PLANE_MASK)) {
-    // Using `dot(dFdxPos, inverse(tr_view)[0].xyz)` would have been enough.
+    // Using `dot(dFdxPos, tr_inverseView[0].xyz)` would have been enough.
     float resolution = max(
-      // TODO: UBO with view and inverse view matrixes.
-      dot(ddxPosition, inverse(tr_view)[0].xyz),
-      dot(ddyPosition, inverse(tr_view)[1].xyz)
+      dot(ddxPosition, tr_inverseView[0].xyz),
+      dot(ddyPosition, tr_inverseView[1].xyz)
     );
 
     // The grid begins to appear when it comprises 4 pixels.
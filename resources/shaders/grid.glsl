@@ -0,0 +1,11 @@
+// GRID_* flags are injected by Grid (see GridFlags.hpp), each variant is
+// compiled with its own TR_GRID_VARIANT: branches on `tr_flags` are constant
+// and folded away by the compiler.
+const uint tr_flags = TR_GRID_VARIANT;
+
+///
+/// Test if a flag (or a mask) validates the given value.
+///
+/// (To test an exact match replace `!= 0u` with `== (FLAGS)`).
+///
+#define testFlag(VALUE, FLAGS) (((VALUE) & (FLAGS)) != 0u)
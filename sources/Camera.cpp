@@ -8,15 +8,32 @@
 
 TR_BEGIN_NAMESPACE()
 
+void Camera::Update(void) const NOEXCEPT {
+  m_view = glm::lookAt(
+    m_position, // Eye/Position
+    m_position + m_target, // Target/Center
+    m_cross // Up/CrossProduct
+  );
+
+  m_projection = glm::perspective(
+    glm::radians(m_fov),
+    AspectRatio(),
+    m_near, m_far
+  );
+
+  m_viewProjection = m_projection * m_view;
+  m_dirty = false;
+}
+
 void Camera::RenderUi(void) NOEXCEPT {
-  bool update = false;
+  bool update = false, changed = false;
   ImGui::SeparatorText("Controls");
 
-  ImGui::DragFloat("FOV", &m_fov, 1.0f, 1.0f, 89.0f, "%.0f");
+  changed |= ImGui::DragFloat("FOV", &m_fov, 1.0f, 1.0f, 89.0f, "%.0f");
   ImGui::DragFloat("Speed", &m_speed, 0.1f, 0.1f, 50.0f, "%.1f");
 
   float planes[2] = { m_near, m_far };
-  ImGui::DragFloat2("Near/Far", planes, 0.1f, 0.1f, 200.f, "%.1f");
+  changed |= ImGui::DragFloat2("Near/Far", planes, 0.1f, 0.1f, 200.f, "%.1f");
   m_near = TR_MIN(planes[0], planes[1]);
   m_far = TR_MAX(planes[0], planes[1]);
 
@@ -27,7 +44,7 @@ void Camera::RenderUi(void) NOEXCEPT {
   m_pitch = TR_CLAMP(rotations[0], -89.0f, 89.0f);
   m_yaw = rotations[1];
 
-  ImGui::DragFloat3("XYZ", glm::value_ptr(m_position), 0.01f, 0.0f, 0.0f, "%.2f");
+  changed |= ImGui::DragFloat3("XYZ", glm::value_ptr(m_position), 0.01f, 0.0f, 0.0f, "%.2f");
 
   if (update) {
     glm::vec3 front;
@@ -36,6 +53,8 @@ void Camera::RenderUi(void) NOEXCEPT {
     front.z = sinf(glm::radians(m_yaw)) * cosf(glm::radians(m_pitch));
     m_target = glm::normalize(front);
   }
+
+  if (update || changed) Invalidate();
 }
 
 void Camera::ProcessMouse(MouseEvent event) NOEXCEPT {
@@ -47,6 +66,7 @@ void Camera::ProcessMouse(MouseEvent event) NOEXCEPT {
   float xOffset = static_cast<float>(event.x - m_lastMouse.x);
   float yOffset = static_cast<float>(m_lastMouse.y - event.y);
   m_lastMouse = event;
+  if (xOffset == 0.0f && yOffset == 0.0f) return;
 
   xOffset *= m_sensitivity;
   yOffset *= m_sensitivity;
@@ -60,14 +80,18 @@ void Camera::ProcessMouse(MouseEvent event) NOEXCEPT {
   front.y = sinf(glm::radians(m_pitch));
   front.z = sinf(glm::radians(m_yaw)) * cosf(glm::radians(m_pitch));
   m_target = glm::normalize(front);
+  Invalidate();
 }
 
 void Camera::ProcessScroll(ScrollEvent event) NOEXCEPT {
+  if (event.yOffset == 0.0) return;
   m_fov -= static_cast<float>(event.yOffset);
   m_fov = TR_CLAMP(m_fov, 1.0, 89.0);
+  Invalidate();
 }
 
 void Camera::ProcessKeyboard(KeyboardEvent event) NOEXCEPT {
+  if (!(event.keyA || event.keyD || event.keyS || event.keyW || event.shift || event.space)) return;
   float cameraSpeed = m_speed * static_cast<float>(event.elapsedTime);
 
   // if (event.keyW) m_position += cameraSpeed * m_target;
@@ -81,6 +105,7 @@ void Camera::ProcessKeyboard(KeyboardEvent event) NOEXCEPT {
 
   if (event.keyA) m_position -= glm::normalize(glm::cross(m_target, m_cross)) * cameraSpeed;
   if (event.keyD) m_position += glm::normalize(glm::cross(m_target, m_cross)) * cameraSpeed;
+  Invalidate();
 }
 
 TR_END_NAMESPACE()
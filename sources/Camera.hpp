@@ -4,6 +4,8 @@
 #include <glm/gtc/matrix_transform.hpp> // glm::lookAt()
 #include <glm/mat4x4.hpp> // glm::mat4{}
 
+#include <cstdint> // uint64_t
+
 #include "helper.hpp" // NOEXCEPT
 #include "Event.hpp" // Event{}
 
@@ -21,7 +23,9 @@ public:
   constexpr void UnFocus(void) NOEXCEPT { m_firstMouse = true; }
 
   constexpr void SetDimensions(int width, int height) NOEXCEPT {
+    if (m_width == width && m_height == height) return;
     m_width = width; m_height = height;
+    Invalidate();
   }
 
 public:
@@ -29,22 +33,30 @@ public:
     return static_cast<float>(m_width) / static_cast<float>(m_height);
   }
 
-  constexpr glm::mat4 LookAt(void) const NOEXCEPT {
-    return glm::lookAt(
-      m_position, // Eye/Position
-      m_position + m_target, // Target/Center
-      m_cross // Up/CrossProduct
-    );
+  /// Cached, only recomputed after the camera has changed.
+  constexpr glm::mat4 const& LookAt(void) const NOEXCEPT {
+    if (m_dirty) Update();
+    return m_view;
+  }
+
+  /// Cached, only recomputed after the camera has changed.
+  constexpr glm::mat4 const& Projection(void) const NOEXCEPT {
+    if (m_dirty) Update();
+    return m_projection;
   }
 
-  constexpr glm::mat4 Projection(void) const NOEXCEPT {
-    return glm::perspective(
-      glm::radians(m_fov),
-      AspectRatio(),
-      m_near, m_far
-    );
+  /// Cached `Projection() * LookAt()`.
+  constexpr glm::mat4 const& ViewProjection(void) const NOEXCEPT {
+    if (m_dirty) Update();
+    return m_viewProjection;
   }
 
+  ///
+  /// Incremented every time the camera changes (moves, rotates, zooms or is
+  /// resized). Downstream caches can compare it to skip their work.
+  ///
+  constexpr uint64_t Version(void) const NOEXCEPT { return m_version; }
+
 public:
   constexpr glm::vec3 Position(void) const NOEXCEPT { return m_position; }
 
@@ -55,6 +67,18 @@ public:
   constexpr float Far(void) const NOEXCEPT { return m_far; }
 
 protected:
+  constexpr void Invalidate(void) NOEXCEPT {
+    m_dirty = true; ++m_version;
+  }
+
+  void Update(void) const NOEXCEPT;
+
+  mutable bool m_dirty = true;
+  mutable glm::mat4 m_view{ 1.0f };
+  mutable glm::mat4 m_projection{ 1.0f };
+  mutable glm::mat4 m_viewProjection{ 1.0f };
+  uint64_t m_version = 1u;
+
   int m_width = 0;
   int m_height = 0;
 
@@ -3,7 +3,11 @@
 
 #include "Cube.hpp" // Cube{}
 #include "Camera.hpp" // Camera{}
+#include "DrawQueue.hpp" // DrawQueue{}, DrawCommand{}
+#include "FrameRequest.hpp" // RequestFrame()
+#include "GLState.hpp" // GLState{}
 #include "Texture.hpp" // Texture{}
+#include "ResourceCache.hpp" // ResourceCache{}
 #include "Shader.hpp" // Shader{}
 
 #define POS(X, Y, Z) (X), (Y), (Z)
@@ -13,6 +17,7 @@
 #define LOCATION0 0 // GLSL: layout (location = 0)
 #define LOCATION1 1 // GLSL: layout (location = 1)
 #define LOCATION2 2 // GLSL: layout (location = 2)
+#define LOCATION3 3 // GLSL: layout (location = 3), a mat4 spans 3 to 6
 
 #define TEXTURE_UNIT0 0
 #define TEXTURE_UNIT1 1
@@ -28,10 +33,25 @@ static char const* CubeVertexShader = R"(
   out vec3 tr_Color;
   out vec2 tr_Texture;
   uniform mat4 model;
-  uniform mat4 view;
-  uniform mat4 projection;
+  #include "frame.glsl"
   void main() {
-    gl_Position = projection * view * model * vec4(position, 1.0f);
+    gl_Position = tr_viewProjection * model * vec4(position, 1.0f);
+    tr_Color = color;
+    tr_Texture = uv;
+  }
+)";
+
+static char const* CubeInstancedVertexShader = R"(
+  #version 330 core
+  layout (location = 0) in vec3 position;
+  layout (location = 1) in vec3 color;
+  layout (location = 2) in vec2 uv;
+  layout (location = 3) in mat4 model;
+  out vec3 tr_Color;
+  out vec2 tr_Texture;
+  #include "frame.glsl"
+  void main() {
+    gl_Position = tr_viewProjection * model * vec4(position, 1.0f);
     tr_Color = color;
     tr_Texture = uv;
   }
@@ -102,19 +122,23 @@ static GLfloat CubeVertices[] = {
   POS(-0.5f, +0.5f, -0.5f), RGB(0.5f, 1.0f, 1.0f), UV(0.0f, 1.0f),
 };
 
-Cube::Cube(void) noexcept
-  : m_texture1("/container.jpg")
-  , m_texture2("/awesomeface.png")
+Cube::Cube(ResourceCache& resources) noexcept
+  : m_texture1(resources.GetTexture("/container.jpg"))
+  , m_texture2(resources.GetTexture("/awesomeface.png"))
+  , m_shader(resources.GetShader("Cube", {
+      { GL_VERTEX_SHADER, CubeVertexShader },
+      { GL_FRAGMENT_SHADER, CubeFragmentShader },
+    }))
+  , m_instancedShader(resources.GetShader("Cube (Instanced)", {
+      { GL_VERTEX_SHADER, CubeInstancedVertexShader },
+      { GL_FRAGMENT_SHADER, CubeFragmentShader },
+    }))
 {
-  m_shader.Attach(GL_VERTEX_SHADER, CubeVertexShader);
-  m_shader.Attach(GL_FRAGMENT_SHADER, CubeFragmentShader);
-  m_shader.Link();
-
   glGenVertexArrays(1, &m_VAO);
   glGenBuffers(1, &m_VBO);
 
-  glBindVertexArray(m_VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+  GLState::BindVertexArray(m_VAO);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_VBO);
   glBufferData(GL_ARRAY_BUFFER, sizeof(CubeVertices), CubeVertices, GL_STATIC_DRAW);
 
   glVertexAttribPointer(LOCATION0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*) (0 * sizeof(GLfloat)));
@@ -123,28 +147,90 @@ Cube::Cube(void) noexcept
   glEnableVertexAttribArray(LOCATION0);
   glEnableVertexAttribArray(LOCATION1);
   glEnableVertexAttribArray(LOCATION2);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+  GLState::BindVertexArray(0);
 
-  m_shader.Use();
-  m_shader.Bind("texture1", TEXTURE_UNIT0);
-  m_shader.Bind("texture2", TEXTURE_UNIT1);
+  glGenVertexArrays(1, &m_instancedVAO);
+  glGenBuffers(1, &m_instanceVBO);
+
+  GLState::BindVertexArray(m_instancedVAO);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_VBO);
+  glVertexAttribPointer(LOCATION0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*) (0 * sizeof(GLfloat)));
+  glVertexAttribPointer(LOCATION1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*) (3 * sizeof(GLfloat)));
+  glVertexAttribPointer(LOCATION2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*) (6 * sizeof(GLfloat)));
+  glEnableVertexAttribArray(LOCATION0);
+  glEnableVertexAttribArray(LOCATION1);
+  glEnableVertexAttribArray(LOCATION2);
+
+  // A mat4 attribute is four vec4 columns, each advanced once per instance.
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+  for (GLuint column = 0u; column < 4u; ++column) {
+    glVertexAttribPointer(LOCATION3 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*) (column * sizeof(glm::vec4)));
+    glEnableVertexAttribArray(LOCATION3 + column);
+    glVertexAttribDivisor(LOCATION3 + column, 1);
+  }
+  GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+  GLState::BindVertexArray(0);
 
   TR_DEBUG("Cube created.");
 }
 
-void Cube::Render(Camera const& camera) NOEXCEPT {
-  m_shader.Use();
+bool Cube::Ready(void) NOEXCEPT {
+  if (m_ready) return true;
+  if (!m_shader->Ready() || !m_instancedShader->Ready()) {
+    if (m_shader->Compiling() || m_instancedShader->Compiling()) RequestFrame();
+    return false;
+  }
+
+  m_shader->Use();
+  m_shader->Bind("texture1", TEXTURE_UNIT0);
+  m_shader->Bind("texture2", TEXTURE_UNIT1);
+
+  m_instancedShader->Use();
+  m_instancedShader->Bind("texture1", TEXTURE_UNIT0);
+  m_instancedShader->Bind("texture2", TEXTURE_UNIT1);
+
+  m_uniformModel = m_shader->Uniform("model");
+  m_ready = true;
+  return true;
+}
+
+void Cube::Render(DrawQueue& queue, Camera const& camera, glm::mat4 const& model) NOEXCEPT {
+  if (!Ready()) return;
+
   // Texture unit = texture location
-  glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, m_texture1);
-  glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, m_texture2);
-
-  glBindVertexArray(m_VAO);
-  m_shader.Bind("model", m_model);
-  m_shader.Bind("view", camera.LookAt());
-  m_shader.Bind("projection", camera.Projection());
-  glDrawArrays(GL_TRIANGLES, 0, 36);
-  glBindVertexArray(0);
+  queue.Push({
+    .program = m_shader->Get(),
+    .vertexArray = m_VAO,
+    .textures = { *m_texture1, *m_texture2 },
+    .model = m_uniformModel,
+    .transform = &model,
+    .count = 36,
+    .depth = -(camera.LookAt() * model[3]).z,
+  });
+}
+
+void Cube::RenderInstanced(DrawQueue& queue, Camera const& camera, std::span<glm::mat4 const> transforms) NOEXCEPT {
+  if (transforms.empty() || !Ready()) return;
+
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+  if (transforms.size() > m_instanceCapacity) {
+    m_instanceCapacity = TR_MAX(transforms.size(), 2u * m_instanceCapacity);
+  }
+  // Orphan the previous storage so the driver does not wait for the last draw.
+  GLsizeiptr capacity = static_cast<GLsizeiptr>(m_instanceCapacity * sizeof(glm::mat4));
+  glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(transforms.size_bytes()), transforms.data());
+  // Left bound, next frame's bind is skipped.
+
+  (void) camera; // One draw for all, no single depth.
+  queue.Push({
+    .program = m_instancedShader->Get(),
+    .vertexArray = m_instancedVAO,
+    .textures = { *m_texture1, *m_texture2 },
+    .count = 36,
+    .instances = static_cast<GLsizei>(transforms.size()),
+  });
 }
 
 TR_END_NAMESPACE()
@@ -4,8 +4,13 @@
 #include <glad/glad.h> // OpenGL API
 #include <glm/mat4x4.hpp>
 
+#include <memory> // std::shared_ptr{}
+#include <span> // std::span{}
+
 #include "Camera.hpp" // Camera{}
+#include "DrawQueue.hpp" // DrawQueue{}
 #include "Texture.hpp" // Texture{}
+#include "ResourceCache.hpp" // ResourceCache{}
 #include "Shader.hpp" // Shader{}
 #include "helper.hpp" // NOEXCEPT
 
@@ -13,24 +18,41 @@ TR_BEGIN_NAMESPACE()
 
 class Cube final {
 public:
-  Cube(void) noexcept;
+  Cube(ResourceCache& resources) noexcept;
 
-  void Render(Camera const& camera) NOEXCEPT;
+  /// Queue a single cube, `model` must outlive the queue execution
+  /// (debugging path).
+  void Render(DrawQueue& queue, Camera const& camera, glm::mat4 const& model) NOEXCEPT;
 
-  constexpr void Transform(glm::mat4 const& transform) NOEXCEPT {
-    m_model = transform;
-  }
+  ///
+  /// Queue one cube per transform as a single instanced draw call.
+  ///
+  /// The transforms are streamed into a per-instance vertex buffer which only
+  /// grows (it is orphaned every frame to avoid synchronisation stalls).
+  ///
+  void RenderInstanced(DrawQueue& queue, Camera const& camera, std::span<glm::mat4 const> transforms) NOEXCEPT;
 
 private:
-  glm::mat4 m_model = { 1.0f };
+  /// Uniform setup, deferred until both programs finished compiling.
+  bool Ready(void) NOEXCEPT;
 
   GLuint m_VAO; // Vertex Array Object
   GLuint m_VBO; // Vertex Buffer Object
 
-  Texture m_texture1;
-  Texture m_texture2;
+  GLuint m_instancedVAO; // Shares m_VBO, plus the per-instance transforms
+  GLuint m_instanceVBO;
+  size_t m_instanceCapacity = 0u;
+
+  // Shared through the ResourceCache.
+  std::shared_ptr<Texture> m_texture1;
+  std::shared_ptr<Texture> m_texture2;
+
+  std::shared_ptr<Shader> m_shader;
+  std::shared_ptr<Shader> m_instancedShader;
 
-  Shader m_shader;
+  // View/Projection come from the shared tr_Frame block (FrameConstants).
+  GLint m_uniformModel = -1;
+  bool m_ready = false;
 };
 
 TR_END_NAMESPACE()
@@ -0,0 +1,119 @@
+#include <glad/glad.h> // OpenGL API
+#include <glm/gtc/type_ptr.hpp> // glm::value_ptr()
+
+#include <bit> // std::bit_cast()
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <mutex> // std::lock_guard{}
+#include <utility> // std::swap()
+#include <vector> // std::vector{}
+
+#include "DrawQueue.hpp" // Self{}
+#include "GLState.hpp" // GLState{}
+#include "helper.hpp" // NOEXCEPT, TR_MAX()
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Stable LSD radix sort of `items` by `key`, one byte per pass. The eight
+/// histograms are counted in a single read, and a pass is skipped when all
+/// keys share its byte (unused layers, a single program...).
+///
+template <typename Item>
+static void RadixSort(std::vector<Item>& items, std::vector<Item>& scratch) NOEXCEPT {
+  size_t count = items.size();
+  if (count < 2u) return;
+  scratch.resize(count);
+
+  size_t histograms[8][256] = {};
+  for (Item const& item: items) {
+    for (uint32_t pass = 0u; pass < 8u; ++pass) {
+      histograms[pass][(item.key >> (8u * pass)) & 0xFFu] += 1u;
+    }
+  }
+
+  Item* source = items.data();
+  Item* destination = scratch.data();
+  for (uint32_t pass = 0u; pass < 8u; ++pass) {
+    uint32_t shift = 8u * pass;
+    size_t* histogram = histograms[pass];
+    if (histogram[(source[0].key >> shift) & 0xFFu] == count) continue;
+
+    // Counts to offsets.
+    size_t offset = 0u;
+    for (size_t byte = 0u; byte < 256u; ++byte) {
+      size_t size = histogram[byte];
+      histogram[byte] = offset;
+      offset += size;
+    }
+
+    for (size_t i = 0u; i < count; ++i) {
+      destination[histogram[(source[i].key >> shift) & 0xFFu]++] = source[i];
+    }
+    std::swap(source, destination);
+  }
+
+  if (source != items.data()) items.swap(scratch);
+}
+
+uint64_t DrawQueue::Key(DrawCommand const& command) NOEXCEPT {
+  uint64_t layer = command.layer & 0xFu;
+  uint64_t program = command.program & 0xFFFu;
+  // Not unique, equal texture sets only have to end up next to each other.
+  uint64_t material = (command.textures[0] ^ (command.textures[1] << 7u)) & 0x7FFFu;
+  // Non-negative floats compare like their bits.
+  uint64_t depth = std::bit_cast<uint32_t>(TR_MAX(command.depth, 0.0f));
+
+  if (command.translucent) {
+    return layer << 60 | uint64_t(1u) << 59 | (~depth & 0xFFFFFFFFu) << 27 | program << 15 | material;
+  }
+  return layer << 60 | program << 47 | material << 32 | depth;
+}
+
+void DrawQueue::Push(DrawCommand const& command) NOEXCEPT {
+  m_items.push_back({ Key(command), static_cast<uint32_t>(m_commands.size()) });
+  m_commands.push_back(command);
+}
+
+void DrawQueue::Execute(void) NOEXCEPT {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  RadixSort(m_items, m_scratch);
+  std::chrono::duration<double, std::milli> sorted = Clock::now() - start;
+
+  // Only the state changes between consecutive commands reach the driver.
+  for (Item const& item: m_items) {
+    DrawCommand const& command = m_commands[item.command];
+    GLState::UseProgram(command.program);
+    GLState::BindVertexArray(command.vertexArray);
+
+    for (GLuint unit = 0u; unit < TR_DRAW_TEXTURES; ++unit) {
+      if (command.textures[unit] != 0u) GLState::BindTexture(unit, command.textures[unit]);
+    }
+
+    if (command.model != -1) {
+      glUniformMatrix4fv(command.model, 1, GL_FALSE, glm::value_ptr(*command.transform));
+    }
+
+    if (command.instances > 0) {
+      glDrawArraysInstanced(command.mode, command.first, command.count, command.instances);
+    }
+    else {
+      glDrawArrays(command.mode, command.first, command.count);
+    }
+  }
+
+  {
+    std::lock_guard lock(m_mutex);
+    m_stats = {
+      .items = m_items.size(),
+      .milliseconds = sorted.count(),
+    };
+  }
+
+  m_items.clear(); // Keeps the capacity
+  m_commands.clear();
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,94 @@
+#ifndef TR_DRAW_QUEUE_HPP
+#define TR_DRAW_QUEUE_HPP
+
+#include <glad/glad.h> // OpenGL API
+#include <glm/mat4x4.hpp> // glm::mat4{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint32_t, uint64_t
+#include <mutex> // std::mutex{}, std::lock_guard{}
+#include <vector> // std::vector{}
+
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_DRAW_TEXTURES 2u // Texture units bound per command
+
+///
+/// One `glDrawArrays[Instanced]()` with the state it needs. Uniforms other
+/// than `model` are program state: set them while queueing.
+///
+struct DrawCommand {
+  GLuint program = 0u;
+  GLuint vertexArray = 0u;
+  GLuint textures[TR_DRAW_TEXTURES] = {}; // GL_TEXTURE_2D per unit, 0 leaves the unit as is
+
+  GLint model = -1; // `mat4` uniform location set to `*transform`, -1 for none
+  glm::mat4 const* transform = NULL; // Must outlive `Execute()`
+
+  GLenum mode = GL_TRIANGLES;
+  GLint first = 0;
+  GLsizei count = 0;
+  GLsizei instances = 0; // Instanced when not 0
+
+  uint8_t layer = 0u; // 0 to 15, drawn in increasing order
+  bool translucent = false; // After the opaque commands of the layer
+  float depth = 0.0f; // View space distance
+};
+
+struct DrawQueueStats {
+  size_t items = 0u;
+  double milliseconds = 0.0; // Sort
+};
+
+///
+/// Draw commands queued by the renderers and executed at once, ordered by a
+/// 64-bit key (radix sorted):
+///
+/// ```
+/// opaque:      layer:4 | 0 | program:12 | material:15 | depth:32
+/// translucent: layer:4 | 1 | ~depth:32  | program:12 | material:15
+/// ```
+///
+/// Opaque commands are grouped by state then drawn front to back (early
+/// depth rejection), translucent ones back to front (blending). Bindings go
+/// through `GLState{}`: only changes reach the driver.
+///
+class DrawQueue final {
+public:
+  DrawQueue(void) NOEXCEPT = default;
+
+  void Push(DrawCommand const& command) NOEXCEPT;
+
+  /// Sort, draw and clear the queue, on the GL thread.
+  void Execute(void) NOEXCEPT;
+
+  /// Copy published by the last `Execute()`, safe from any thread.
+  inline DrawQueueStats Stats(void) const NOEXCEPT {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+  }
+
+private:
+  TR_DELETE_COPY_CTOR(DrawQueue);
+  TR_DELETE_MOVE_CTOR(DrawQueue);
+
+  struct Item {
+    uint64_t key;
+    uint32_t command; // Index in `m_commands`
+  };
+
+  static uint64_t Key(DrawCommand const& command) NOEXCEPT;
+
+  std::vector<Item> m_items;
+  std::vector<Item> m_scratch; // Radix sort ping-pong
+  std::vector<DrawCommand> m_commands;
+
+  mutable std::mutex m_mutex;
+  DrawQueueStats m_stats{};
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_DRAW_QUEUE_HPP
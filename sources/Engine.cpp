@@ -1,17 +1,27 @@
 #include "imgui/imgui.h"
 
 #include <glad/glad.h> // OpenGL Loader
+#include <glm/gtc/constants.hpp> // glm::pi(), glm::two_pi()
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp> // glm::mat4{}
 #include <glm/vec3.hpp> // glm::vec3{}
 
+#include <chrono> // std::chrono::steady_clock{}
+#include <cmath> // cbrtf()
+#include <random> // std::uniform_real_distribution{}
+
 #include "Cube.hpp" // Cube{}
 #include "Engine.hpp" // Engine{}
+#include "FrameRequest.hpp" // RequestFrame()
+#include "Frustum.hpp" // Frustum{}, CullSpheres()
+#include "Scene.hpp" // Scene{}
+#include "Transform.hpp" // BuildModelMatrices()
 #include "helper.hpp" // TR_ARRAYSIZE()
 
 TR_BEGIN_NAMESPACE()
 
-static glm::vec3 positions[] = {
+// Initial scene.
+static glm::vec3 const positions[] = {
   glm::vec3( 0.0f, 0.0f, 0.0f),
   glm::vec3( 2.0f, 5.0f, -15.0f),
   glm::vec3(-1.5f, -2.2f, -2.5f),
@@ -24,16 +34,126 @@ static glm::vec3 positions[] = {
   glm::vec3(-1.3f, 1.0f, -1.5f)
 };
 
-void Engine::Render(Event event) NOEXCEPT {
+Engine::Engine(void) NOEXCEPT {
   for (size_t i = 0u; i < TR_ARRAYSIZE(positions); ++i) {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, positions[i]);
-    float angle = static_cast<float>(event.currentTime) * 15.0f * static_cast<float>(i+1);
-    model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-    m_cube.Transform(model);
-    m_cube.Render(m_camera);
+    m_scene.Add({
+      .position = positions[i],
+      .axis = glm::vec3(1.0f, 0.3f, 0.5f),
+      .spin = glm::radians(15.0f * static_cast<float>(i+1)),
+      .flags = Scene::FLAG_VISIBLE | Scene::FLAG_ANIMATED,
+    });
+  }
+}
+
+void Engine::Animate(double elapsedTime) NOEXCEPT {
+  float elapsed = static_cast<float>(elapsedTime);
+  std::span<float> spins = m_scene.Spins();
+  std::span<uint32_t const> flags = m_scene.EntityFlags();
+  std::vector<float>& angles = m_scene.Transforms().angle;
+
+  bool animated = false;
+  for (size_t i = 0u; i < m_scene.Size(); ++i) {
+    if (flags[i] & Scene::FLAG_ANIMATED) {
+      // Wrapped to keep the SIMD sin/cos range reduction accurate.
+      angles[i] = fmodf(angles[i] + spins[i] * elapsed, glm::two_pi<float>());
+      animated = true;
+    }
+  }
+
+  if (animated) RequestFrame(); // Keep moving
+}
+
+void Engine::Spawn(size_t count) NOEXCEPT {
+  float extent = 3.0f * cbrtf(static_cast<float>(m_scene.Size() + count));
+  std::uniform_real_distribution<float> position(-extent, extent);
+  std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> spin(-glm::pi<float>(), glm::pi<float>());
+
+  m_scene.Reserve(m_scene.Size() + count);
+  for (size_t i = 0u; i < count; ++i) {
+    m_scene.Add({
+      .position = glm::vec3(position(m_random), position(m_random), -extent + position(m_random)),
+      .axis = glm::vec3(axis(m_random), axis(m_random), axis(m_random)) + glm::vec3(0.0f, 0.0f, 2.0f),
+      .spin = spin(m_random),
+      .flags = Scene::FLAG_VISIBLE | Scene::FLAG_ANIMATED,
+    });
   }
-  m_grid.Render(m_camera);
+}
+
+void Engine::Despawn(size_t count) NOEXCEPT {
+  for (size_t i = 0u; i < count && m_scene.Size() > 0u; ++i) {
+    std::uniform_int_distribution<size_t> index(0u, m_scene.Size() - 1u);
+    m_scene.Remove(m_scene.At(index(m_random)));
+  }
+}
+
+void Engine::Cull(void) NOEXCEPT {
+  auto start = std::chrono::steady_clock::now();
+  m_visible.resize(m_scene.Size());
+
+  size_t visible = 0u;
+  if (m_frustumCulling) {
+    TransformArrays const& transforms = m_scene.Transforms();
+    visible = CullSpheres(Frustum::FromMatrix(m_camera.ViewProjection()), {
+      .x = transforms.x.data(),
+      .y = transforms.y.data(),
+      .z = transforms.z.data(),
+      .radius = m_scene.Radii().data(),
+      .flags = m_scene.EntityFlags().data(),
+      .mask = Scene::FLAG_VISIBLE,
+      .count = m_scene.Size(),
+    }, m_visible.data());
+  }
+  else {
+    std::span<uint32_t const> flags = m_scene.EntityFlags();
+    for (size_t i = 0u; i < m_scene.Size(); ++i) {
+      if (flags[i] & Scene::FLAG_VISIBLE) m_visible[visible++] = static_cast<uint32_t>(i);
+    }
+  }
+  m_visible.resize(visible);
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  m_culling = { .tested = m_scene.Size(), .visible = visible, .milliseconds = elapsed.count() };
+}
+
+void Engine::Update(Event event, EngineFrame& frame) NOEXCEPT {
+  Animate(event.elapsedTime);
+
+  m_models.resize(m_scene.Size());
+  BuildModelMatrices(m_scene.Transforms().Streams(), m_models.data());
+
+  Cull();
+  frame.instances.clear(); // Keeps the capacity
+  for (uint32_t index: m_visible) {
+    frame.instances.push_back(m_models[index]);
+  }
+
+  frame.event = event;
+  frame.camera = m_camera;
+  frame.instanced = m_instanced;
+  frame.grid = m_grid.GetSettings();
+}
+
+// Time given to texture uploads each frame (at least one is uploaded).
+static constexpr double s_uploadBudget = 2.0; // Milliseconds
+
+void Engine::Submit(EngineFrame const& frame) NOEXCEPT {
+  m_textures.Update(s_uploadBudget);
+  m_resources.Collect();
+  m_frame.Update(frame.camera);
+
+  if (frame.instanced) {
+    m_cube.RenderInstanced(m_queue, frame.camera, frame.instances);
+  }
+  else {
+    // One draw per cube, kept for debugging.
+    for (glm::mat4 const& model: frame.instances) {
+      m_cube.Render(m_queue, frame.camera, model);
+    }
+  }
+
+  m_grid.Render(m_queue, frame.camera, frame.grid);
+  m_queue.Execute();
 }
 
 void Engine::RenderUi(void) NOEXCEPT {
@@ -45,23 +165,46 @@ void Engine::RenderUi(void) NOEXCEPT {
     ImGui::TreePop();
   }
 
+  ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+  if (ImGui::TreeNode("Scene")) {
+    ImGui::Text("%zu entities", m_scene.Size());
+    if (ImGui::Button("+1K")) Spawn(1000u);
+    ImGui::SameLine(); if (ImGui::Button("+100K")) Spawn(100000u);
+    ImGui::SameLine(); if (ImGui::Button("-1K")) Despawn(1000u);
+    ImGui::SameLine(); if (ImGui::Button("Clear")) m_scene.Clear();
+    ImGui::Checkbox("Instanced", &m_instanced);
+    ImGui::SameLine(); ImGui::Checkbox("Frustum Culling", &m_frustumCulling);
+    ImGui::TreePop();
+  }
+
   ImGui::SetNextItemOpen(true, ImGuiCond_Once);
   if (ImGui::TreeNode("Grid")) {
     m_grid.RenderUi();
     ImGui::TreePop();
   }
+
+  if (ImGui::TreeNode("Resources")) {
+    m_resources.RenderUi();
+    ImGui::TreePop();
+  }
 }
 
 void Engine::ProcessMouse(MouseEvent event) NOEXCEPT {
+  uint64_t version = m_camera.Version();
   m_camera.ProcessMouse(event);
+  if (m_camera.Version() != version) RequestFrame();
 }
 
 void Engine::ProcessScroll(ScrollEvent event) NOEXCEPT {
+  uint64_t version = m_camera.Version();
   m_camera.ProcessScroll(event);
+  if (m_camera.Version() != version) RequestFrame();
 }
 
 void Engine::ProcessKeyboard(KeyboardEvent event) NOEXCEPT {
+  uint64_t version = m_camera.Version();
   m_camera.ProcessKeyboard(event);
+  if (m_camera.Version() != version) RequestFrame();
 }
 
 void Engine::Focus(void) NOEXCEPT {
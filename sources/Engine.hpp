@@ -1,9 +1,22 @@
 #ifndef TR_ENGINE_HPP
 #define TR_ENGINE_HPP
 
+#include <glm/mat4x4.hpp> // glm::mat4{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <random> // std::mt19937{}
+#include <vector> // std::vector{}
+
 #include "helper.hpp" // NOEXCEPT
 #include "Camera.hpp" // Camera{}
+#include "DrawQueue.hpp" // DrawQueue{}, DrawQueueStats{}
 #include "Event.hpp" // Event{}
+#include "FrameConstants.hpp" // FrameConstants{}
+#include "ResourceCache.hpp" // ResourceCache{}
+#include "Frustum.hpp" // CullingStats{}
+#include "Scene.hpp" // Scene{}
+#include "TextureLoader.hpp" // TextureLoader{}
 #include "Theme.hpp" // Theme{}
 
 #include "Cube.hpp" // Cube{}
@@ -11,9 +24,27 @@
 
 TR_BEGIN_NAMESPACE()
 
+///
+/// What `Engine::Submit()` draws, filled by `Engine::Update()`. The draw
+/// side only reads it and the GL objects it owns: both sides may run on
+/// different threads (see `RenderThread{}`).
+///
+struct EngineFrame {
+  Event event{};
+  Camera camera{};
+  std::vector<glm::mat4> instances; // Visible entities only
+  bool instanced = true;
+  Grid::Settings grid{};
+};
+
 class Engine final {
 public:
-  void Render(Event event) NOEXCEPT;
+  Engine(void) NOEXCEPT;
+
+  /// Simulate and cull (CPU only, no OpenGL).
+  void Update(Event event, EngineFrame& frame) NOEXCEPT;
+  /// Upload pending resources and draw `frame`, on the GL thread.
+  void Submit(EngineFrame const& frame) NOEXCEPT;
   void RenderUi(void) NOEXCEPT;
 
   void ProcessMouse(MouseEvent event) NOEXCEPT;
@@ -31,11 +62,43 @@ public:
     m_camera.SetDimensions(width, height);
   }
 
+  constexpr CullingStats const& Culling(void) const NOEXCEPT {
+    return m_culling;
+  }
+
+  inline TextureLoaderStats Textures(void) const NOEXCEPT {
+    return m_textures.Stats();
+  }
+
+  inline DrawQueueStats Draws(void) const NOEXCEPT {
+    return m_queue.Stats();
+  }
+
 private:
+  void Animate(double elapsedTime) NOEXCEPT;
+  void Cull(void) NOEXCEPT;
+  void Spawn(size_t count) NOEXCEPT;
+  void Despawn(size_t count) NOEXCEPT;
+
   Camera m_camera{};
+  FrameConstants m_frame{}; // GL thread
+  DrawQueue m_queue{}; // GL thread
+
+  // Declared before the meshes referencing them.
+  TextureLoader m_textures{};
+  ResourceCache m_resources{m_textures};
+
+  Cube m_cube{m_resources};
+  Grid m_grid{m_resources};
+
+  Scene m_scene{};
+  std::mt19937 m_random{};
 
-  Cube m_cube{};
-  Grid m_grid{};
+  bool m_instanced = true;
+  bool m_frustumCulling = true;
+  CullingStats m_culling{};
+  std::vector<uint32_t> m_visible; // Dense indices surviving the culling
+  std::vector<glm::mat4> m_models; // One per entity (dense order)
 };
 
 TR_END_NAMESPACE()
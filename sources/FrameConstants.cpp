@@ -0,0 +1,43 @@
+#include <glad/glad.h> // OpenGL API
+#include <glm/gtc/matrix_inverse.hpp> // glm::affineInverse()
+
+#include "Camera.hpp" // Camera{}
+#include "FrameConstants.hpp" // Self{}
+#include "GLState.hpp" // GLState{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+FrameConstants::FrameConstants(void) NOEXCEPT {
+  glGenBuffers(1, &m_UBO);
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), NULL, GL_DYNAMIC_DRAW);
+  GLState::BindBufferBase(GL_UNIFORM_BUFFER, TR_FRAME_BINDING, m_UBO);
+}
+
+FrameConstants::~FrameConstants(void) NOEXCEPT {
+  GLState::DeleteBuffer(m_UBO);
+}
+
+void FrameConstants::Update(Camera const& camera) NOEXCEPT {
+  if (camera.Version() == m_version) {
+    GLState::BindBufferBase(GL_UNIFORM_BUFFER, TR_FRAME_BINDING, m_UBO);
+    return;
+  }
+
+  m_version = camera.Version();
+  m_block.view = camera.LookAt();
+  m_block.projection = camera.Projection();
+  m_block.viewProjection = camera.ViewProjection();
+  // The view matrix is rigid, no need for a general 4x4 inverse.
+  m_block.inverseView = glm::affineInverse(m_block.view);
+  m_block.position = camera.Position();
+  m_block.near = camera.Near();
+  m_block.far = camera.Far();
+
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &m_block);
+  GLState::BindBufferBase(GL_UNIFORM_BUFFER, TR_FRAME_BINDING, m_UBO);
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,77 @@
+#ifndef TR_FRAME_CONSTANTS_HPP
+#define TR_FRAME_CONSTANTS_HPP
+
+#include <glad/glad.h> // OpenGL API
+#include <glm/mat4x4.hpp> // glm::mat4{}
+#include <glm/vec3.hpp> // glm::vec3{}
+
+#include <cstddef> // offsetof()
+#include <cstdint> // uint64_t
+
+#include "Camera.hpp" // Camera{}
+#include "helper.hpp" // NOEXCEPT
+
+#define TR_FRAME_BLOCK "tr_Frame" // GLSL: layout (std140) uniform tr_Frame
+#define TR_FRAME_BINDING 0u // Linked by Shader::Link()
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Per-frame constants shared by every shader through a uniform buffer.
+///
+/// Declared in "resources/shaders/frame.glsl" (`#include "frame.glsl"`) as:
+///
+/// ```glsl
+/// layout (std140) uniform tr_Frame {
+///   mat4 tr_view;
+///   mat4 tr_projection;
+///   mat4 tr_viewProjection;
+///   mat4 tr_inverseView;
+///   vec3 tr_camera;
+///   float tr_near;
+///   float tr_far;
+/// };
+/// ```
+///
+class FrameConstants final {
+public:
+  /// std140 layout of `tr_Frame`.
+  struct Block {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 inverseView;
+    glm::vec3 position;
+    float near;
+    float far;
+    float _padding[3];
+  };
+
+  static_assert(offsetof(Block, position) == 256);
+  static_assert(offsetof(Block, near) == 268);
+  static_assert(offsetof(Block, far) == 272);
+  static_assert(sizeof(Block) == 288);
+
+public:
+  FrameConstants(void) NOEXCEPT;
+  ~FrameConstants(void) NOEXCEPT;
+
+  /// Fill the block from the camera and upload it, unless it has not changed.
+  void Update(Camera const& camera) NOEXCEPT;
+
+  constexpr Block const& Get(void) const NOEXCEPT {
+    return m_block;
+  }
+
+private:
+  TR_DELETE_COPY_CTOR(FrameConstants);
+  TR_DELETE_MOVE_CTOR(FrameConstants);
+
+  GLuint m_UBO; // Uniform Buffer Object
+  Block m_block{};
+  uint64_t m_version = 0u; // Camera::Version() of the uploaded block
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_FRAME_CONSTANTS_HPP
@@ -0,0 +1,132 @@
+#include "imgui/imgui.h"
+
+#include <glad/glad.h> // Before GLFW
+#include <GLFW/glfw3.h> // glfwExtensionSupported()
+
+#include <cfloat> // FLT_MAX
+#include <chrono> // std::chrono::duration{}
+#include <cmath> // sqrt()
+#include <thread> // std::this_thread::sleep_for(), std::this_thread::yield()
+
+#include "FramePacer.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT, TR_ARRAYSIZE(), TR_CLAMP(), TR_MIN(), TR_MAX()
+#include "Log.hpp" // TR_WARNING(), TR_DEBUG()
+
+TR_BEGIN_NAMESPACE()
+
+FramePacer::FramePacer(void) NOEXCEPT
+  : m_deadline(Clock::now()), m_last(m_deadline)
+{
+  m_tearControl = (false
+    || glfwExtensionSupported("WGL_EXT_swap_control_tear")
+    || glfwExtensionSupported("GLX_EXT_swap_control_tear")
+  );
+  TR_DEBUG("Adaptive vsync: %s", m_tearControl ? "supported" : "not supported");
+}
+
+void FramePacer::SetMode(PacingMode mode) NOEXCEPT {
+  if (mode == PacingMode::Adaptive && !m_tearControl) {
+    TR_WARNING("Adaptive vsync is not supported, falling back to vsync.");
+    mode = PacingMode::VSync;
+  }
+
+  m_mode = mode;
+  m_deadline = Clock::now();
+  m_count = 0u; // The previous mode would skew the statistics.
+}
+
+void FramePacer::SetTargetFps(double fps) NOEXCEPT {
+  m_targetFps = TR_CLAMP(fps, 10.0, 1000.0);
+}
+
+void FramePacer::Wait(void) NOEXCEPT {
+  if (m_mode == PacingMode::Limiter) {
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetFps));
+
+    // A late frame moves the schedule: catching up would present the next
+    // frames back to back, which is what pacing is meant to avoid.
+    m_deadline = TR_MAX(m_deadline, m_last) + period;
+    Sleep(m_deadline);
+  }
+
+  Record(Clock::now());
+}
+
+void FramePacer::Sleep(Clock::time_point deadline) NOEXCEPT {
+  // Coarse: the OS may oversleep, only sleep while it cannot miss.
+  for (;;) {
+    double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+    if (remaining <= m_sleepEstimate) break;
+
+    Clock::time_point start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double observed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    m_sleepCount += 1u;
+    double delta = observed - m_sleepMean;
+    m_sleepMean += delta / static_cast<double>(m_sleepCount);
+    m_sleepM2 += delta * (observed - m_sleepMean);
+    m_sleepEstimate = m_sleepMean + sqrt(m_sleepM2 / static_cast<double>(m_sleepCount - 1u));
+  }
+
+  // Fine: spin on the monotonic clock.
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+void FramePacer::Record(Clock::time_point now) NOEXCEPT {
+  double interval = std::chrono::duration<double, std::milli>(now - m_last).count();
+  m_last = now;
+
+  m_intervals[m_count % TR_PACER_HISTORY] = static_cast<float>(interval);
+  m_count += 1u;
+
+  size_t count = TR_MIN(m_count, size_t(TR_PACER_HISTORY));
+  double sum = 0.0, min = FLT_MAX, max = 0.0;
+  for (size_t i = 0u; i < count; ++i) {
+    double value = static_cast<double>(m_intervals[i]);
+    sum += value;
+    min = TR_MIN(min, value);
+    max = TR_MAX(max, value);
+  }
+
+  double mean = sum / static_cast<double>(count), variance = 0.0;
+  for (size_t i = 0u; i < count; ++i) {
+    double delta = static_cast<double>(m_intervals[i]) - mean;
+    variance += delta * delta;
+  }
+
+  m_stats = {
+    .mean = mean,
+    .deviation = sqrt(variance / static_cast<double>(count)),
+    .min = min, .max = max,
+  };
+}
+
+void FramePacer::RenderUi(void) NOEXCEPT {
+  static char const* s_modeNames[] = { "Unlimited", "VSync", "Adaptive VSync", "Limiter" };
+
+  int mode = static_cast<int>(m_mode);
+  if (ImGui::Combo("Pacing", &mode, s_modeNames, static_cast<int>(TR_ARRAYSIZE(s_modeNames)))) {
+    SetMode(static_cast<PacingMode>(mode));
+  }
+
+  if (m_mode == PacingMode::Limiter) {
+    float fps = static_cast<float>(m_targetFps);
+    if (ImGui::SliderFloat("Target FPS", &fps, 10.0f, 360.0f, "%.0f")) {
+      SetTargetFps(static_cast<double>(fps));
+    }
+  }
+
+  ImGui::Text(
+    "Frame %.2f ms +/- %.3f ms (min %.2f, max %.2f)",
+    m_stats.mean, m_stats.deviation, m_stats.min, m_stats.max
+  );
+
+  size_t count = TR_MIN(m_count, size_t(TR_PACER_HISTORY));
+  int offset = m_count < TR_PACER_HISTORY ? 0 : static_cast<int>(m_count % TR_PACER_HISTORY);
+  ImGui::PlotLines("##Intervals", m_intervals.data(), static_cast<int>(count), offset, NULL, 0.0f, FLT_MAX, ImVec2(-1.0f, 40.0f));
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,93 @@
+#ifndef TR_FRAME_PACER_HPP
+#define TR_FRAME_PACER_HPP
+
+#include <array> // std::array{}
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstddef> // size_t
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_PACER_HISTORY 240u // Frame intervals kept for the statistics
+
+enum class PacingMode: int {
+  Unlimited, // As fast as possible (swap interval 0)
+  VSync, // Swap interval 1
+  Adaptive, // Swap interval -1: tears instead of halving the rate when late
+  Limiter, // Swap interval 0, software limit to `TargetFps()`
+};
+
+/// Intervals between presented frames, in milliseconds.
+struct FramePacerStats {
+  double mean = 0.0, deviation = 0.0;
+  double min = 0.0, max = 0.0;
+};
+
+///
+/// Pace the main loop, `Wait()` is called once per frame after the swap (or
+/// after the frame is queued to the render thread, which then blocks the
+/// main thread through the frames in flight).
+///
+/// The swap interval is applied by the thread owning the context, see
+/// `SwapInterval()`.
+///
+/// The limiter sleeps while the deadline is further than the estimated
+/// oversleep of the OS (mean + deviation of the observed 1 ms sleeps), then
+/// spins on the monotonic clock: sub-millisecond precision without burning
+/// the whole frame.
+///
+class FramePacer final {
+public:
+  /// Needs the current OpenGL context (tear control extensions).
+  FramePacer(void) NOEXCEPT;
+
+  void SetMode(PacingMode mode) NOEXCEPT;
+  void SetTargetFps(double fps) NOEXCEPT;
+
+  void Wait(void) NOEXCEPT;
+
+  constexpr PacingMode Mode(void) const NOEXCEPT { return m_mode; }
+  constexpr double TargetFps(void) const NOEXCEPT { return m_targetFps; }
+  constexpr FramePacerStats const& Stats(void) const NOEXCEPT { return m_stats; }
+
+  /// For `glfwSwapInterval()`.
+  constexpr int SwapInterval(void) const NOEXCEPT {
+    switch (m_mode) {
+      case PacingMode::VSync: return 1;
+      case PacingMode::Adaptive: return -1;
+      default: return 0; // Unlimited, Limiter
+    }
+  }
+
+  void RenderUi(void) NOEXCEPT;
+
+private:
+  TR_DELETE_COPY_CTOR(FramePacer);
+  TR_DELETE_MOVE_CTOR(FramePacer);
+
+  using Clock = std::chrono::steady_clock;
+
+  void Sleep(Clock::time_point deadline) NOEXCEPT;
+  void Record(Clock::time_point now) NOEXCEPT;
+
+  PacingMode m_mode = PacingMode::Unlimited;
+  bool m_tearControl = false; // Adaptive vsync is supported
+  double m_targetFps = 60.0;
+
+  Clock::time_point m_deadline; // Next frame (limiter)
+  Clock::time_point m_last; // Last `Wait()` return
+
+  // Oversleep estimate (Welford), in seconds.
+  double m_sleepEstimate = 5e-3;
+  double m_sleepMean = 5e-3, m_sleepM2 = 0.0;
+  size_t m_sleepCount = 1u;
+
+  std::array<float, TR_PACER_HISTORY> m_intervals{}; // Milliseconds
+  size_t m_count = 0u;
+  FramePacerStats m_stats;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_FRAME_PACER_HPP
@@ -0,0 +1,29 @@
+#include <glad/glad.h> // Before GLFW
+#include <GLFW/glfw3.h> // glfwPostEmptyEvent()
+
+#include <atomic> // std::atomic{}
+#include <cstdint> // uint32_t
+
+#include "FrameRequest.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+static constinit std::atomic<uint32_t> s_frames{0u};
+
+void RequestFrame(uint32_t frames) NOEXCEPT {
+  // Requests overlap (three requests of one frame are one frame).
+  uint32_t pending = s_frames.load(std::memory_order_relaxed);
+  while (pending < frames && !s_frames.compare_exchange_weak(pending, frames, std::memory_order_relaxed));
+
+  // Thread-safe, wakes up glfwWaitEvents*().
+  if (pending == 0u) glfwPostEmptyEvent();
+}
+
+bool ConsumeFrameRequest(void) NOEXCEPT {
+  uint32_t pending = s_frames.load(std::memory_order_relaxed);
+  while (pending > 0u && !s_frames.compare_exchange_weak(pending, pending - 1u, std::memory_order_relaxed));
+  return pending > 0u;
+}
+
+TR_END_NAMESPACE()
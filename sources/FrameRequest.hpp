@@ -0,0 +1,24 @@
+#ifndef TR_FRAME_REQUEST_HPP
+#define TR_FRAME_REQUEST_HPP
+
+#include <cstdint> // uint32_t
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Ask the main loop for at least `frames` more frames, from any thread.
+///
+/// In render-on-demand mode nothing is drawn unless input arrives or a
+/// system requests a frame: animations, asynchronous loads completing,
+/// programs still compiling... A waiting main loop is woken up.
+///
+void RequestFrame(uint32_t frames = 1u) NOEXCEPT;
+
+/// Consume one requested frame, false when none is pending (main thread).
+bool ConsumeFrameRequest(void) NOEXCEPT;
+
+TR_END_NAMESPACE()
+
+#endif // TR_FRAME_REQUEST_HPP
@@ -0,0 +1,143 @@
+#include <glm/geometric.hpp> // glm::length()
+#include <glm/mat4x4.hpp> // glm::mat4{}
+#include <glm/vec4.hpp> // glm::vec4{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // SSE2, AVX2
+#define TR_FRUSTUM_X86 1
+#else
+#define TR_FRUSTUM_X86 0
+#endif
+
+#include "Frustum.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+Frustum Frustum::FromMatrix(glm::mat4 const& m) NOEXCEPT {
+  // GLM is column-major: row I is (m[0][I], m[1][I], m[2][I], m[3][I]).
+  glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  Frustum frustum;
+  frustum.planes[LEFT]   = row3 + row0;
+  frustum.planes[RIGHT]  = row3 - row0;
+  frustum.planes[BOTTOM] = row3 + row1;
+  frustum.planes[TOP]    = row3 - row1;
+  frustum.planes[NEAR]   = row3 + row2; // OpenGL clip space: -w <= z
+  frustum.planes[FAR]    = row3 - row2;
+
+  for (glm::vec4& plane: frustum.planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+
+  return frustum;
+}
+
+static size_t CullScalar(Frustum const& frustum, SphereStreams const& s, size_t first, uint32_t* visible) NOEXCEPT {
+  size_t count = 0u;
+  for (size_t i = first; i < s.count; ++i) {
+    bool inside = (s.flags[i] & s.mask) != 0u;
+    for (int plane = 0; inside && plane < Frustum::_PLANE_TOTAL; ++plane) {
+      glm::vec4 const& p = frustum.planes[plane];
+      inside = p.x * s.x[i] + p.y * s.y[i] + p.z * s.z[i] + p.w >= -s.radius[i];
+    }
+    if (inside) visible[count++] = static_cast<uint32_t>(i);
+  }
+  return count;
+}
+
+#if TR_FRUSTUM_X86
+
+/// Append the indices of the set bits of `bits` (offset by `base`).
+static inline size_t Compact(uint32_t bits, size_t base, uint32_t* visible) NOEXCEPT {
+  size_t count = 0u;
+  while (bits != 0u) {
+    visible[count++] = static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctz(bits)));
+    bits &= bits - 1u;
+  }
+  return count;
+}
+
+static size_t CullSSE(Frustum const& frustum, SphereStreams const& s, size_t* done, uint32_t* visible) NOEXCEPT {
+  size_t i = 0u, count = 0u;
+  __m128i const mask = _mm_set1_epi32(static_cast<int>(s.mask));
+
+  for (; i + 4u <= s.count; i += 4u) {
+    __m128 x = _mm_loadu_ps(s.x + i);
+    __m128 y = _mm_loadu_ps(s.y + i);
+    __m128 z = _mm_loadu_ps(s.z + i);
+    __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(s.radius + i));
+
+    __m128i flags = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(s.flags + i)), mask);
+    __m128 inside = _mm_castsi128_ps(_mm_cmpeq_epi32(flags, _mm_setzero_si128()));
+    inside = _mm_xor_ps(inside, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+    for (glm::vec4 const& plane: frustum.planes) {
+      __m128 distance = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+        _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w))
+      );
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+    }
+
+    count += Compact(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, visible + count);
+  }
+
+  *done = i;
+  return count;
+}
+
+__attribute__((target("avx2,fma")))
+static size_t CullAVX2(Frustum const& frustum, SphereStreams const& s, size_t* done, uint32_t* visible) NOEXCEPT {
+  size_t i = 0u, count = 0u;
+  __m256i const mask = _mm256_set1_epi32(static_cast<int>(s.mask));
+
+  for (; i + 8u <= s.count; i += 8u) {
+    __m256 x = _mm256_loadu_ps(s.x + i);
+    __m256 y = _mm256_loadu_ps(s.y + i);
+    __m256 z = _mm256_loadu_ps(s.z + i);
+    __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(s.radius + i));
+
+    __m256i flags = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(s.flags + i)), mask);
+    __m256 inside = _mm256_castsi256_ps(_mm256_cmpeq_epi32(flags, _mm256_setzero_si256()));
+    inside = _mm256_xor_ps(inside, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+
+    for (glm::vec4 const& plane: frustum.planes) {
+      __m256 distance = _mm256_fmadd_ps(x, _mm256_set1_ps(plane.x),
+        _mm256_fmadd_ps(y, _mm256_set1_ps(plane.y),
+          _mm256_fmadd_ps(z, _mm256_set1_ps(plane.z), _mm256_set1_ps(plane.w))
+        )
+      );
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+    }
+
+    count += Compact(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, visible + count);
+  }
+
+  *done = i;
+  return count;
+}
+
+#endif // TR_FRUSTUM_X86
+
+size_t CullSpheres(Frustum const& frustum, SphereStreams const& spheres, uint32_t* visible) NOEXCEPT {
+  size_t done = 0u, count = 0u;
+
+#if TR_FRUSTUM_X86
+  static bool const s_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  count = s_avx2
+    ? CullAVX2(frustum, spheres, &done, visible)
+    : CullSSE(frustum, spheres, &done, visible);
+#endif
+
+  // Remainder (and fallback).
+  return count + CullScalar(frustum, spheres, done, visible + count);
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,60 @@
+#ifndef TR_FRUSTUM_HPP
+#define TR_FRUSTUM_HPP
+
+#include <glm/mat4x4.hpp> // glm::mat4{}
+#include <glm/vec4.hpp> // glm::vec4{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Six normalised planes `(n, d)`, a point `p` is inside when
+/// `dot(n, p) + d >= 0` for every plane.
+///
+struct Frustum {
+  enum Plane { LEFT = 0, RIGHT, BOTTOM, TOP, NEAR, FAR, _PLANE_TOTAL };
+
+  glm::vec4 planes[_PLANE_TOTAL];
+
+  /// Gribb-Hartmann extraction from an OpenGL view-projection matrix.
+  static Frustum FromMatrix(glm::mat4 const& viewProjection) NOEXCEPT;
+};
+
+///
+/// Bounding spheres as structure-of-arrays, one entry per object.
+///
+/// Objects whose `flags` do not intersect `mask` are rejected without being
+/// tested against the planes.
+///
+struct SphereStreams {
+  float const* x;
+  float const* y;
+  float const* z;
+  float const* radius;
+  uint32_t const* flags;
+  uint32_t mask;
+  size_t count;
+};
+
+struct CullingStats {
+  size_t tested = 0u;
+  size_t visible = 0u;
+  double milliseconds = 0.0;
+};
+
+///
+/// Test spheres against the frustum, 8 (AVX2) or 4 (SSE2) at a time, and
+/// write the indices of the visible ones contiguously.
+///
+/// @pre `visible` holds at least `spheres.count` indices.
+/// @returns The number of visible spheres written to `visible`.
+///
+size_t CullSpheres(Frustum const& frustum, SphereStreams const& spheres, uint32_t* visible) NOEXCEPT;
+
+TR_END_NAMESPACE()
+
+#endif // TR_FRUSTUM_HPP
@@ -0,0 +1,208 @@
+#include <glad/glad.h> // OpenGL API
+
+#include <cstdint> // int8_t, uint64_t
+#include <initializer_list> // std::initializer_list{}
+#include <mutex> // std::mutex{}, std::lock_guard{}
+
+#include "GLState.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+// Never a GL name nor a valid enum value.
+static constexpr GLuint s_unknown = UINT32_MAX;
+
+// Only touched by the GL thread (the context is current on one at a time).
+static struct {
+  GLuint program;
+  GLuint unit; // Active texture unit
+  GLuint textures[TR_GL_TEXTURE_UNITS];
+  GLuint vertexArray;
+  GLuint arrayBuffer, uniformBuffer, unpackBuffer;
+  GLuint uniformBindings[TR_GL_UNIFORM_BINDINGS];
+  int8_t blend, depthTest, cullFace, scissorTest; // -1 when unknown
+  GLenum blendSource, blendDestination;
+  GLenum depthFunction;
+  int8_t depthMask;
+  GLenum polygonMode;
+} s_state;
+
+static uint64_t s_issued = 0u, s_skipped = 0u;
+
+static std::mutex s_mutex;
+static GLStateStats s_published{};
+
+/// Update `shadow`, true when the call has to be issued.
+template <typename Type>
+static bool Change(Type& shadow, Type value) NOEXCEPT {
+  if (shadow == value) {
+    s_skipped += 1u;
+    return false;
+  }
+  shadow = value;
+  s_issued += 1u;
+  return true;
+}
+
+static GLuint* Buffer(GLenum target) NOEXCEPT {
+  switch (target) {
+    case GL_ARRAY_BUFFER: return &s_state.arrayBuffer;
+    case GL_UNIFORM_BUFFER: return &s_state.uniformBuffer;
+    case GL_PIXEL_UNPACK_BUFFER: return &s_state.unpackBuffer;
+    default: return NULL;
+  }
+}
+
+static int8_t* Capability(GLenum capability) NOEXCEPT {
+  switch (capability) {
+    case GL_BLEND: return &s_state.blend;
+    case GL_DEPTH_TEST: return &s_state.depthTest;
+    case GL_CULL_FACE: return &s_state.cullFace;
+    case GL_SCISSOR_TEST: return &s_state.scissorTest;
+    default: return NULL;
+  }
+}
+
+void GLState::Reset(void) NOEXCEPT {
+  s_state.program = s_unknown;
+  s_state.unit = s_unknown;
+  for (GLuint& texture: s_state.textures) texture = s_unknown;
+  s_state.vertexArray = s_unknown;
+  s_state.arrayBuffer = s_state.uniformBuffer = s_state.unpackBuffer = s_unknown;
+  for (GLuint& buffer: s_state.uniformBindings) buffer = s_unknown;
+  s_state.blend = s_state.depthTest = s_state.cullFace = s_state.scissorTest = -1;
+  s_state.blendSource = s_state.blendDestination = s_unknown;
+  s_state.depthFunction = s_unknown;
+  s_state.depthMask = -1;
+  s_state.polygonMode = s_unknown;
+}
+
+void GLState::UseProgram(GLuint program) NOEXCEPT {
+  if (Change(s_state.program, program)) glUseProgram(program);
+}
+
+void GLState::ActiveTexture(GLuint unit) NOEXCEPT {
+  if (Change(s_state.unit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::BindTexture(GLuint texture) NOEXCEPT {
+  if (s_state.unit >= TR_GL_TEXTURE_UNITS) {
+    // Unknown (or not shadowed) unit.
+    s_issued += 1u;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    return;
+  }
+  if (Change(s_state.textures[s_state.unit], texture)) glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLState::BindTexture(GLuint unit, GLuint texture) NOEXCEPT {
+  if (unit < TR_GL_TEXTURE_UNITS && s_state.textures[unit] == texture) {
+    s_skipped += 1u;
+    return;
+  }
+  ActiveTexture(unit);
+  BindTexture(texture);
+}
+
+void GLState::BindVertexArray(GLuint vertexArray) NOEXCEPT {
+  if (Change(s_state.vertexArray, vertexArray)) glBindVertexArray(vertexArray);
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer) NOEXCEPT {
+  GLuint* shadow = Buffer(target);
+  if (shadow == NULL) {
+    s_issued += 1u;
+    glBindBuffer(target, buffer);
+    return;
+  }
+  if (Change(*shadow, buffer)) glBindBuffer(target, buffer);
+}
+
+void GLState::BindBufferBase(GLenum target, GLuint index, GLuint buffer) NOEXCEPT {
+  GLuint* shadow = Buffer(target);
+  if (target != GL_UNIFORM_BUFFER || index >= TR_GL_UNIFORM_BINDINGS) {
+    s_issued += 1u;
+    glBindBufferBase(target, index, buffer);
+    if (shadow != NULL) *shadow = buffer;
+    return;
+  }
+  if (Change(s_state.uniformBindings[index], buffer)) {
+    glBindBufferBase(target, index, buffer);
+    *shadow = buffer;
+  }
+}
+
+void GLState::Enable(GLenum capability, bool enabled) NOEXCEPT {
+  int8_t* shadow = Capability(capability);
+  if (shadow != NULL && !Change(*shadow, static_cast<int8_t>(enabled))) return;
+  if (shadow == NULL) s_issued += 1u;
+
+  if (enabled) glEnable(capability);
+  else glDisable(capability);
+}
+
+void GLState::BlendFunc(GLenum source, GLenum destination) NOEXCEPT {
+  if (s_state.blendSource == source && s_state.blendDestination == destination) {
+    s_skipped += 1u;
+    return;
+  }
+  s_state.blendSource = source;
+  s_state.blendDestination = destination;
+  s_issued += 1u;
+  glBlendFunc(source, destination);
+}
+
+void GLState::DepthFunc(GLenum function) NOEXCEPT {
+  if (Change(s_state.depthFunction, function)) glDepthFunc(function);
+}
+
+void GLState::DepthMask(bool write) NOEXCEPT {
+  if (Change(s_state.depthMask, static_cast<int8_t>(write))) glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void GLState::PolygonMode(GLenum mode) NOEXCEPT {
+  if (Change(s_state.polygonMode, mode)) glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+void GLState::DeleteProgram(GLuint program) NOEXCEPT {
+  // Stays in use until another one is: only forget it.
+  if (s_state.program == program) s_state.program = s_unknown;
+  glDeleteProgram(program);
+}
+
+void GLState::DeleteTexture(GLuint texture) NOEXCEPT {
+  for (GLuint& bound: s_state.textures) {
+    if (bound == texture) bound = 0u;
+  }
+  glDeleteTextures(1, &texture);
+}
+
+void GLState::DeleteVertexArray(GLuint vertexArray) NOEXCEPT {
+  if (s_state.vertexArray == vertexArray) s_state.vertexArray = 0u;
+  glDeleteVertexArrays(1, &vertexArray);
+}
+
+void GLState::DeleteBuffer(GLuint buffer) NOEXCEPT {
+  for (GLuint* bound: { &s_state.arrayBuffer, &s_state.uniformBuffer, &s_state.unpackBuffer }) {
+    if (*bound == buffer) *bound = 0u;
+  }
+  for (GLuint& bound: s_state.uniformBindings) {
+    if (bound == buffer) bound = 0u;
+  }
+  glDeleteBuffers(1, &buffer);
+}
+
+void GLState::EndFrame(void) NOEXCEPT {
+  {
+    std::lock_guard lock(s_mutex);
+    s_published = { .issued = s_issued, .skipped = s_skipped };
+  }
+  s_issued = s_skipped = 0u;
+}
+
+GLStateStats GLState::Stats(void) NOEXCEPT {
+  std::lock_guard lock(s_mutex);
+  return s_published;
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,88 @@
+#ifndef TR_GL_STATE_HPP
+#define TR_GL_STATE_HPP
+
+#include <glad/glad.h> // OpenGL API
+
+#include <cstdint> // uint64_t
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_GL_TEXTURE_UNITS 16u // Shadowed units, the others are always issued
+#define TR_GL_UNIFORM_BINDINGS 8u // Shadowed uniform buffer binding points
+
+struct GLStateStats {
+  uint64_t issued = 0u; // Calls that reached the driver
+  uint64_t skipped = 0u; // Redundant ones filtered out
+};
+
+///
+/// Shadow of the bound OpenGL state: program, texture units, vertex array,
+/// buffers, blending, depth and polygon mode. Calls setting what is already
+/// bound never reach the driver.
+///
+/// Every engine class changes this state through here (GL thread only), or
+/// restores it before returning (the Dear ImGui backend does). Anything else
+/// touching the context must call `Reset()` afterwards, as must a new
+/// context once current.
+///
+class GLState final {
+public:
+  /// Forget the shadowed state, the next calls are all issued.
+  static void Reset(void) NOEXCEPT;
+
+  static void UseProgram(GLuint program) NOEXCEPT;
+
+  /// `GL_TEXTURE0 + unit`.
+  static void ActiveTexture(GLuint unit) NOEXCEPT;
+
+  /// `GL_TEXTURE_2D` on the active unit.
+  static void BindTexture(GLuint texture) NOEXCEPT;
+
+  /// `GL_TEXTURE_2D` on `unit`, only made active when the binding changes.
+  static void BindTexture(GLuint unit, GLuint texture) NOEXCEPT;
+
+  static void BindVertexArray(GLuint vertexArray) NOEXCEPT;
+
+  /// Array, uniform and pixel unpack buffers are shadowed. The element array
+  /// buffer is vertex array state: always issued.
+  static void BindBuffer(GLenum target, GLuint buffer) NOEXCEPT;
+
+  /// Also binds `buffer` to `target` (`GL_UNIFORM_BUFFER` is shadowed).
+  static void BindBufferBase(GLenum target, GLuint index, GLuint buffer) NOEXCEPT;
+
+  /// `GL_BLEND`, `GL_DEPTH_TEST`, `GL_CULL_FACE` and `GL_SCISSOR_TEST` are
+  /// shadowed.
+  static void Enable(GLenum capability, bool enabled = true) NOEXCEPT;
+
+  inline static void Disable(GLenum capability) NOEXCEPT {
+    Enable(capability, false);
+  }
+
+  static void BlendFunc(GLenum source, GLenum destination) NOEXCEPT;
+  static void DepthFunc(GLenum function) NOEXCEPT;
+  static void DepthMask(bool write) NOEXCEPT;
+
+  /// `GL_FRONT_AND_BACK`.
+  static void PolygonMode(GLenum mode) NOEXCEPT;
+
+  // Deleted objects are unbound by the driver, their names reused.
+  static void DeleteProgram(GLuint program) NOEXCEPT;
+  static void DeleteTexture(GLuint texture) NOEXCEPT;
+  static void DeleteVertexArray(GLuint vertexArray) NOEXCEPT;
+  static void DeleteBuffer(GLuint buffer) NOEXCEPT;
+
+  /// Publish the counters of the frame and start over (GL thread).
+  static void EndFrame(void) NOEXCEPT;
+
+  /// Counters of the last frame, safe from any thread.
+  static GLStateStats Stats(void) NOEXCEPT;
+
+private:
+  GLState(void) NOEXCEPT = delete;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_GL_STATE_HPP
@@ -5,32 +5,40 @@
 #include <glad/glad.h> // OpenGL API
 #include <glm/gtc/type_ptr.hpp> // glm::make_vec4()
 
+#include <cstdio> // snprintf()
+#include <memory> // std::shared_ptr{}
+#include <utility> // std::move()
+#include <vector> // std::vector{}
+
 #include "Grid.hpp" // Grid{}
 #include "Camera.hpp" // Camera{}
-#include "Shader.hpp" // Shader{}
+#include "DrawQueue.hpp" // DrawQueue{}, DrawCommand{}
+#include "FrameRequest.hpp" // RequestFrame()
+#include "GridFlags.hpp" // TR_GRID_FLAGS()
+#include "ResourceCache.hpp" // ResourceCache{}
+#include "Shader.hpp" // Shader{}, ShaderDefine{}
 #include "helper.hpp" // NOEXCEPT
 
 TR_BEGIN_NAMESPACE()
 
-Grid::Grid(void) NOEXCEPT
-  : m_VAO(0u), m_flags(GRID_NONE), m_lineSize(0.2f)
+Grid::Grid(ResourceCache& resources) NOEXCEPT
+  : m_resources(resources), m_settings(), m_VAO(0u)
+  , m_variant(GRID_NONE)
 {
-  m_flags = static_cast<Flags>(SHOW_GRID | GRID_AXIS_X | GRID_AXIS_Z | GRID_PLANE_XZ);
+  m_settings.flags = static_cast<Flags>(SHOW_GRID | GRID_AXIS_X | GRID_AXIS_Z | GRID_PLANE_XZ);
+  m_variant = m_settings.flags;
+  m_pending = Variant(m_variant);
 
   glGenVertexArrays(1, &m_VAO);
 
-  m_shader.Attach("grid.vert.glsl");
-  m_shader.Attach("grid.frag.glsl");
-  m_shader.Link();
-
   TR_DEBUG("Grid created.");
 }
 
 void Grid::RenderUi(void) NOEXCEPT {
 
-  ImU64 show = m_flags & SHOW_GRID;
-  ImU64 axis = m_flags & GRID_AXIS_MASK;
-  ImU64 plane = m_flags & GRID_PLANE_MASK;
+  ImU64 show = m_settings.flags & SHOW_GRID;
+  ImU64 axis = m_settings.flags & GRID_AXIS_MASK;
+  ImU64 plane = m_settings.flags & GRID_PLANE_MASK;
 
   static char const* axisLabels[3] = { "X", "Y", "Z" };
   static char const* planeLabels[3] = { "XY", "YZ", "XZ" };
@@ -38,50 +46,85 @@ void Grid::RenderUi(void) NOEXCEPT {
   static ImU64 axisFlags[3] = { GRID_AXIS_X, GRID_AXIS_Y, GRID_AXIS_Z };
   static ImU64 planeFlags[3] = { GRID_PLANE_XY, GRID_PLANE_YZ, GRID_PLANE_XZ };
 
-  ImGui::DragFloat("Line Size", &m_lineSize, 0.01f, 0.01f, 2.0f, "%.1f");
+  ImGui::DragFloat("Line Size", &m_settings.lineSize, 0.01f, 0.01f, 2.0f, "%.1f");
   ImGui::ButtonFlagsGroup("Axis", &axis, axisFlags, axisLabels, 3);
   ImGui::ButtonFlagsGroup("Floor", &plane, planeFlags, planeLabels, 3, ImGuiButtonFlagsGroup_Exclusive);
   ImGui::CheckboxFlags("Show Grid", &show, SHOW_GRID);
 
-  m_flags = static_cast<Flags>(show | axis | plane);
+  m_settings.flags = static_cast<Flags>(show | axis | plane);
+}
+
+std::shared_ptr<Shader> Grid::Variant(Flags flags) NOEXCEPT {
+  char variant[16];
+  snprintf(variant, sizeof(variant), "0x%03xu", static_cast<unsigned>(flags));
+
+  std::vector<ShaderDefine> defines = {
+#define TR_GRID_FLAG(NAME, VALUE) { #NAME, #VALUE },
+    TR_GRID_FLAGS(TR_GRID_FLAG)
+#undef TR_GRID_FLAG
+    { "TR_GRID_VARIANT", variant },
+  };
+
+  return m_resources.GetShader({ "grid.vert.glsl", "grid.frag.glsl" }, defines);
 }
 
 void Grid::OnThemeUpdate(Theme& theme) NOEXCEPT {
-  m_shader.Use();
   // TODO: Probably temporary
+  // Kept until a program is ready (see `Render()`).
   ImVec4 colorGrid         = theme.Get(Theme::ColorGrid);
   ImVec4 colorGridEmphasis = theme.Get(Theme::ColorGridEmphasis);
-
-  m_shader.Bind("tr_colorGrid"        , glm::make_vec4(&colorGrid.x));
-  m_shader.Bind("tr_colorGridEmphasis", glm::make_vec4(&colorGridEmphasis.x));
+  m_settings.colors.grid         = glm::make_vec4(&colorGrid.x);
+  m_settings.colors.gridEmphasis = glm::make_vec4(&colorGridEmphasis.x);
 
   ImVec4 colorAxisX = theme.Get(Theme::ColorAxisX);
   ImVec4 colorAxisY = theme.Get(Theme::ColorAxisY);
   ImVec4 colorAxisZ = theme.Get(Theme::ColorAxisZ);
+  m_settings.colors.axisX = glm::make_vec4(&colorAxisX.x);
+  m_settings.colors.axisY = glm::make_vec4(&colorAxisY.x);
+  m_settings.colors.axisZ = glm::make_vec4(&colorAxisZ.x);
 
-  m_shader.Bind("tr_colorGridAxisX", glm::make_vec4(&colorAxisX.x));
-  m_shader.Bind("tr_colorGridAxisY", glm::make_vec4(&colorAxisY.x));
-  m_shader.Bind("tr_colorGridAxisZ", glm::make_vec4(&colorAxisZ.x));
+  m_settings.colorsVersion += 1u;
 }
 
 // TODO: Render the othogonal axis to the current plane when requested (glDepthFunc(GL_ALWAYS)?)
-void Grid::Render(Camera const& camera) NOEXCEPT {
-  if ((m_flags & (GRID_AXIS_MASK | GRID_PLANE_MASK)) == GRID_NONE) return;
-
-  m_shader.Use();
-  glBindVertexArray(m_VAO);
-
-  m_shader.Bind("tr_view", camera.LookAt());
-  m_shader.Bind("tr_projection", camera.Projection());
-  m_shader.Bind("tr_camera", camera.Position());
-  m_shader.Bind("tr_near", camera.Near());
-  m_shader.Bind("tr_far", camera.Far());
-  m_shader.Bind("tr_flags", m_flags);
-  m_shader.Bind("tr_lineSize", m_lineSize);
-
-  // Attribute-less rendering.
-  glDrawArrays(GL_TRIANGLES, 0, 6);
-  glBindVertexArray(0);
+void Grid::Render(DrawQueue& queue, Camera const& camera, Settings const& settings) NOEXCEPT {
+  if ((settings.flags & (GRID_AXIS_MASK | GRID_PLANE_MASK)) == GRID_NONE) return;
+
+  // Request the variant, the previous one is drawn while it compiles.
+  if (settings.flags != m_variant) {
+    m_variant = settings.flags;
+    m_pending = Variant(settings.flags);
+  }
+  if (m_pending && m_pending->Ready()) {
+    m_shader = std::move(m_pending);
+    m_colorsVersion = UINT64_MAX; // New program, upload them again
+  }
+  else if (m_pending && m_pending->Compiling()) {
+    RequestFrame(); // Poll it again
+  }
+  if (!m_shader) return;
+
+  // Uniforms are program state, set before the queue executes.
+  m_shader->Use();
+
+  if (m_colorsVersion != settings.colorsVersion) {
+    m_shader->Bind("tr_colorGrid"        , settings.colors.grid);
+    m_shader->Bind("tr_colorGridEmphasis", settings.colors.gridEmphasis);
+    m_shader->Bind("tr_colorGridAxisX", settings.colors.axisX);
+    m_shader->Bind("tr_colorGridAxisY", settings.colors.axisY);
+    m_shader->Bind("tr_colorGridAxisZ", settings.colors.axisZ);
+    m_colorsVersion = settings.colorsVersion;
+  }
+
+  m_shader->Bind("tr_lineSize", settings.lineSize);
+
+  // Attribute-less rendering, blended over the opaque geometry.
+  queue.Push({
+    .program = m_shader->Get(),
+    .vertexArray = m_VAO,
+    .count = 6,
+    .translucent = true,
+  });
 }
 
 TR_END_NAMESPACE()
@@ -2,8 +2,15 @@
 #define TR_GRID_HPP
 
 #include <glad/glad.h> // OpenGL
+#include <glm/vec4.hpp> // glm::vec4{}
+
+#include <cstdint> // uint64_t
+#include <memory> // std::shared_ptr{}
 
 #include "Camera.hpp" // Camera{}
+#include "DrawQueue.hpp" // DrawQueue{}
+#include "GridFlags.hpp" // TR_GRID_FLAGS()
+#include "ResourceCache.hpp" // ResourceCache{}
 #include "Shader.hpp" // Shader{}
 #include "Theme.hpp" // Theme{}
 #include "helper.hpp" // NOEXCEPT
@@ -13,33 +20,53 @@ TR_BEGIN_NAMESPACE()
 class Grid final {
 private:
   enum Flags: GLuint {
-    GRID_NONE = 0x0u,
-    SHOW_GRID = 0x1u,
-
-    GRID_AXIS_X    = 0x010u,
-    GRID_AXIS_Y    = 0x020u,
-    GRID_AXIS_Z    = 0x040u,
-    GRID_AXIS_MASK = 0x070u,
-
-    GRID_PLANE_XY   = 0x100u,
-    GRID_PLANE_YZ   = 0x200u,
-    GRID_PLANE_XZ   = 0x400u,
-    GRID_PLANE_MASK = 0x700u,
+#define TR_GRID_FLAG(NAME, VALUE) NAME = VALUE,
+    TR_GRID_FLAGS(TR_GRID_FLAG)
+#undef TR_GRID_FLAG
   };
 
 public:
-  Grid(void) NOEXCEPT;
+  /// Edited by the UI, drawn from a copy (see `EngineFrame{}`).
+  struct Settings {
+    Flags flags = GRID_NONE;
+    GLfloat lineSize = 0.2f;
+    struct {
+      glm::vec4 grid, gridEmphasis;
+      glm::vec4 axisX, axisY, axisZ;
+    } colors{};
+    uint64_t colorsVersion = 0u; // Bumped by `OnThemeUpdate()`
+  };
 
-  void Render(Camera const& camera) NOEXCEPT;
+public:
+  Grid(ResourceCache& resources) NOEXCEPT;
+
+  void Render(DrawQueue& queue, Camera const& camera, Settings const& settings) NOEXCEPT;
   void RenderUi(void) NOEXCEPT;
 
   void OnThemeUpdate(Theme& theme) NOEXCEPT;
 
+  constexpr Settings const& GetSettings(void) const NOEXCEPT {
+    return m_settings;
+  }
+
 private:
+  /// Program specialised for `flags` (`TR_GRID_VARIANT`), shared by the cache.
+  std::shared_ptr<Shader> Variant(Flags flags) NOEXCEPT;
+
+  ResourceCache& m_resources;
+  Settings m_settings;
+
+  // GL thread only (`Render()`).
   GLuint m_VAO;
-  Shader m_shader;
-  Flags m_flags;
-  GLfloat m_lineSize;
+
+  // Drawn variant, kept until the requested one finished compiling.
+  // Camera matrices come from the shared tr_Frame block (FrameConstants).
+  std::shared_ptr<Shader> m_shader;
+  std::shared_ptr<Shader> m_pending;
+  Flags m_variant;
+
+  // Theme colors are uploaded when the version changes (or on variant switch).
+  uint64_t m_colorsVersion = UINT64_MAX;
 };
 
 TR_END_NAMESPACE()
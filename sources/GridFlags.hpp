@@ -0,0 +1,24 @@
+#ifndef TR_GRID_FLAGS_HPP
+#define TR_GRID_FLAGS_HPP
+
+///
+/// Grid flags, shared by the C++ enum (`Grid::Flags`) and the GLSL shaders
+/// (injected as `#define`s when compiling a Grid variant).
+///
+/// X(NAME, VALUE), values are GLSL-compatible `uint` literals.
+///
+#define TR_GRID_FLAGS(X) \
+  X(GRID_NONE, 0x000u) \
+  X(SHOW_GRID, 0x001u) \
+  \
+  X(GRID_AXIS_X,    0x010u) \
+  X(GRID_AXIS_Y,    0x020u) \
+  X(GRID_AXIS_Z,    0x040u) \
+  X(GRID_AXIS_MASK, 0x070u) \
+  \
+  X(GRID_PLANE_XY,   0x100u) \
+  X(GRID_PLANE_YZ,   0x200u) \
+  X(GRID_PLANE_XZ,   0x400u) \
+  X(GRID_PLANE_MASK, 0x700u)
+
+#endif // TR_GRID_FLAGS_HPP
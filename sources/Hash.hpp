@@ -0,0 +1,29 @@
+#ifndef TR_HASH_HPP
+#define TR_HASH_HPP
+
+#include <cstdint> // uint64_t
+#include <string_view> // std::string_view{}
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_HASH_SEED 0xCBF29CE484222325ull // FNV-1a 64-bit offset basis
+#define TR_HASH_PRIME 0x00000100000001B3ull // FNV-1a 64-bit prime
+
+///
+/// FNV-1a (64-bit), usable at compile-time.
+///
+/// Hashes can be chained by passing the previous result as `seed`.
+///
+constexpr uint64_t Hash(std::string_view data, uint64_t seed = TR_HASH_SEED) NOEXCEPT {
+  for (char c: data) {
+    seed ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+    seed *= TR_HASH_PRIME;
+  }
+  return seed;
+}
+
+TR_END_NAMESPACE()
+
+#endif // TR_HASH_HPP
@@ -0,0 +1,197 @@
+#include <glad/glad.h> // OpenGL API
+#include <GLFW/glfw3.h> // GLFW Library
+
+#include <algorithm> // std::sort(), std::find_if()
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstdio> // FILE, fopen(), fprintf()
+#include <cstring> // strcmp()
+#include <filesystem> // std::filesystem::path{}, std::filesystem::create_directories()
+#include <optional> // std::optional{}, std::nullopt
+#include <system_error> // std::error_code{}
+#include <utility> // std::in_place
+#include <vector> // std::vector{}
+
+#include "Headless.hpp" // Self{}
+#include "Window.hpp" // Window::CreateContext()
+#include "Log.hpp" // TR_ERROR(), TR_INFO(), GlobalLogFlush()
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+std::optional<Headless> Headless::Create(HeadlessOptions const& options) NOEXCEPT {
+  GLFWwindow* window = Window::CreateContext(options.width, options.height, false);
+  if (window == NULL) return std::nullopt;
+  return std::optional<Headless>(std::in_place, window, options);
+}
+
+Headless::Headless(GLFWwindow* window, HeadlessOptions const& options) NOEXCEPT
+  : m_options(options), m_window(window), m_engine(), m_frame(), m_theme(), m_profiler()
+{
+  // The default framebuffer of a hidden window may not be backed, render
+  // into our own at a fixed size instead.
+  glGenRenderbuffers(2, m_RBOs);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_RBOs[0]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, options.width, options.height);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_RBOs[1]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, options.width, options.height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &m_FBO);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_RBOs[0]);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_RBOs[1]);
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    TR_ERROR("Benchmark framebuffer is incomplete.");
+  }
+
+  ImVec4 viewport = m_theme.Get(Theme::ColorViewport);
+  glClearColor(viewport.x, viewport.y, viewport.z, 1.0f);
+  m_engine.OnThemeUpdate(m_theme);
+}
+
+Headless::~Headless(void) NOEXCEPT {
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glDeleteFramebuffers(1, &m_FBO);
+  glDeleteRenderbuffers(2, m_RBOs);
+
+  TR_ASSERT_RECOVERABLE(m_window != NULL);
+  glfwDestroyWindow(m_window);
+  glfwTerminate();
+  m_window = NULL;
+}
+
+bool Headless::Run(void) NOEXCEPT {
+  using Clock = std::chrono::steady_clock;
+
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    return false;
+  }
+
+  TR_INFO(
+    "Benchmark: %u frames (+%u warm-up) at %dx%d on %s"
+    , m_options.frames, m_options.warmup, m_options.width, m_options.height
+    , reinterpret_cast<char const*>(glGetString(GL_RENDERER))
+  );
+
+  glViewport(0, 0, m_options.width, m_options.height);
+  m_engine.SetViewport(m_options.width, m_options.height);
+  m_frames.reserve(m_options.frames);
+
+  Clock::time_point start = Clock::now();
+  uint32_t total = m_options.warmup + m_options.frames;
+
+  for (uint32_t i = 0u; i < total; ++i) {
+    if (i == m_options.warmup) start = Clock::now();
+
+    uint64_t index = m_profiler.FrameIndex();
+    m_profiler.BeginFrame();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    {
+      Profiler::Zone zone(m_profiler, "Engine::Render", true);
+      m_engine.Update({
+        .currentTime = static_cast<double>(i + 1u) * m_options.timestep,
+        .elapsedTime = m_options.timestep,
+      }, m_frame);
+      m_engine.Submit(m_frame);
+    }
+
+    { Profiler::Zone zone(m_profiler, "glFinish"); glFinish(); }
+    m_profiler.EndFrame();
+
+    // Finished: the queries of this frame are available.
+    m_profiler.Resolve();
+    ProfilerFrame const* frame = m_profiler.Frame(index);
+    if (i >= m_options.warmup && frame != NULL) Record(*frame);
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return Write(seconds);
+}
+
+void Headless::Record(ProfilerFrame const& frame) NOEXCEPT {
+  m_frames.push_back(static_cast<double>(frame.end - frame.start) / 1e6);
+
+  for (ProfilerZone const& zone: frame.zones) {
+    if (zone.gpu && !frame.resolved) continue;
+
+    auto phase = std::find_if(m_phases.begin(), m_phases.end(), [&](Phase const& phase) {
+      return phase.gpu == zone.gpu && strcmp(phase.name, zone.name) == 0;
+    });
+    if (phase == m_phases.end()) {
+      phase = m_phases.insert(m_phases.end(), { zone.name, zone.gpu, {} });
+      phase->samples.reserve(m_options.frames);
+    }
+    phase->samples.push_back(static_cast<double>(zone.end - zone.start) / 1e6);
+  }
+}
+
+/// Mean and percentiles of `samples` (sorted in place) as a JSON object.
+static void WriteStats(FILE* file, std::vector<double>& samples) NOEXCEPT {
+  if (samples.empty()) {
+    fprintf(file, "{\"count\":0}");
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  double sum = 0.0;
+  for (double sample: samples) sum += sample;
+
+  auto percentile = [&](double p) {
+    size_t index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1u) + 0.5);
+    return samples[index];
+  };
+
+  fprintf(file,
+    "{\"count\":%zu,\"mean\":%.4f,\"min\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f}",
+    samples.size(), sum / static_cast<double>(samples.size()),
+    samples.front(), percentile(0.50), percentile(0.95), percentile(0.99), samples.back()
+  );
+}
+
+bool Headless::Write(double seconds) const NOEXCEPT {
+  FILE* file = stdout;
+  bool toStdout = strcmp(m_options.output, "-") == 0;
+
+  if (!toStdout) {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(m_options.output).parent_path(), error);
+    file = fopen(m_options.output, "w");
+    if (file == NULL) {
+      TR_ERROR("Failed to open benchmark results: %s", m_options.output);
+      return false;
+    }
+  }
+  else {
+    GlobalLogFlush(); // Do not interleave with the logs.
+  }
+
+  // Copies, `WriteStats()` sorts.
+  std::vector<double> frames = m_frames;
+  std::vector<Phase> phases = m_phases;
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"renderer\": \"%s\",\n", reinterpret_cast<char const*>(glGetString(GL_RENDERER)));
+  fprintf(file, "  \"version\": \"%s\",\n", reinterpret_cast<char const*>(glGetString(GL_VERSION)));
+  fprintf(file, "  \"width\": %d, \"height\": %d,\n", m_options.width, m_options.height);
+  fprintf(file, "  \"frames\": %u, \"warmup\": %u, \"timestep\": %.6f,\n", m_options.frames, m_options.warmup, m_options.timestep);
+  fprintf(file, "  \"seconds\": %.3f,\n", seconds);
+  fprintf(file, "  \"frame_ms\": "); WriteStats(file, frames); fprintf(file, ",\n");
+  fprintf(file, "  \"phases_ms\": [");
+  for (size_t i = 0u; i < phases.size(); ++i) {
+    fprintf(file, "%s\n    {\"name\":\"%s\",\"clock\":\"%s\",\"stats\":", i == 0u ? "" : ",",
+      phases[i].name, phases[i].gpu ? "gpu" : "cpu");
+    WriteStats(file, phases[i].samples);
+    fprintf(file, "}");
+  }
+  fprintf(file, "\n  ]\n}\n");
+
+  if (!toStdout) {
+    fclose(file);
+    TR_INFO("Benchmark results written to %s", m_options.output);
+  }
+  return true;
+}
+
+TR_END_NAMESPACE()
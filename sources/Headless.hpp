@@ -0,0 +1,76 @@
+#ifndef TR_HEADLESS_HPP
+#define TR_HEADLESS_HPP
+
+#include <glad/glad.h> // GLuint
+#include <GLFW/glfw3.h> // GLFWwindow{}
+
+#include <cstdint> // uint32_t
+#include <optional> // std::optional{}
+#include <vector> // std::vector{}
+
+#include "Engine.hpp" // Engine{}, EngineFrame{}
+#include "Profiler.hpp" // Profiler{}, ProfilerFrame{}
+#include "Theme.hpp" // Theme{}
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+/// Parsed from `--bench` command line options (see `main()`).
+struct HeadlessOptions {
+  uint32_t frames = 1000u; // Measured frames
+  uint32_t warmup = 120u; // Frames rendered first (shaders, textures)
+  int width = 1280, height = 720;
+  double timestep = 1.0 / 60.0; // Seconds per frame (simulated)
+  char const* output = TR_BUILD_DIR "/bench/results.json"; // "-" for stdout
+};
+
+///
+/// Benchmark mode: render the default scene offscreen for a fixed number of
+/// frames with a fixed timestep, without ImGui, then write frame time and
+/// per-phase statistics as JSON.
+///
+/// The context comes from an invisible GLFW window (Mesa llvmpipe works),
+/// falling back to the GLFW null platform (OSMesa) where there is no display.
+/// Every frame is finished (`glFinish()`) so that frame times include the
+/// GPU and runs are comparable.
+///
+class Headless final {
+public:
+  static std::optional<Headless> Create(HeadlessOptions const& options) NOEXCEPT;
+
+public:
+   Headless(GLFWwindow* window, HeadlessOptions const& options) NOEXCEPT;
+  ~Headless(void) NOEXCEPT;
+
+  bool Run(void) NOEXCEPT;
+
+private:
+  TR_DELETE_COPY_CTOR(Headless);
+  TR_DELETE_MOVE_CTOR(Headless);
+
+  struct Phase {
+    char const* name;
+    bool gpu;
+    std::vector<double> samples; // Milliseconds
+  };
+
+  void Record(ProfilerFrame const& frame) NOEXCEPT;
+  bool Write(double seconds) const NOEXCEPT;
+
+  HeadlessOptions m_options;
+  GLFWwindow* m_window;
+  GLuint m_FBO = 0u;
+  GLuint m_RBOs[2] = {}; // Color, depth and stencil
+
+  Engine m_engine;
+  EngineFrame m_frame;
+  Theme m_theme;
+  Profiler m_profiler;
+
+  std::vector<double> m_frames; // Milliseconds
+  std::vector<Phase> m_phases;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_HEADLESS_HPP
@@ -0,0 +1,28 @@
+#include "InputQueue.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+static_assert((TR_INPUT_CAPACITY & (TR_INPUT_CAPACITY - 1u)) == 0u);
+
+InputQueue::InputQueue(void) NOEXCEPT
+  : m_events()
+  , m_base(glfwGetTimerValue())
+  , m_frequency(static_cast<double>(glfwGetTimerFrequency()))
+{}
+
+void InputQueue::Push(InputEvent const& event) NOEXCEPT {
+  if (m_head - m_tail == TR_INPUT_CAPACITY) {
+    // Full (high polling rate mice): positions are absolute, the latest
+    // one replaces the previous one.
+    InputEvent& last = m_events[(m_head - 1u) % TR_INPUT_CAPACITY];
+    if (event.type == InputType::Mouse && last.type == InputType::Mouse) last = event;
+    else m_dropped += 1u;
+    return;
+  }
+
+  m_events[m_head % TR_INPUT_CAPACITY] = event;
+  m_head += 1u;
+}
+
+TR_END_NAMESPACE()
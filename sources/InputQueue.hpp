@@ -0,0 +1,103 @@
+#ifndef TR_INPUT_QUEUE_HPP
+#define TR_INPUT_QUEUE_HPP
+
+#include <glad/glad.h> // Before GLFW
+#include <GLFW/glfw3.h> // GLFW_KEY_LAST, glfwGetTimerValue()
+
+#include <array> // std::array{}
+#include <bitset> // std::bitset{}
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint64_t
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_INPUT_CAPACITY 1024u // Events per frame, a power of two
+
+enum class InputType: uint8_t {
+  Key,
+  Mouse,
+  Scroll,
+};
+
+struct InputEvent {
+  uint64_t ticks; // glfwGetTimerValue()
+  InputType type;
+  int key, action; // Key
+  double x, y; // Mouse position, scroll offsets
+};
+
+///
+/// Input recorded by the GLFW callbacks (inside glfwPollEvents()), drained
+/// once per frame by `Window::ProcessInput()`. Fixed capacity, no
+/// allocation: when full, mouse moves are merged into the last one (the
+/// position is absolute) and other events are dropped and counted.
+///
+/// Timestamps use the raw GLFW timer, `Seconds()` shares the base with
+/// `Now()` so frames and events can be compared.
+///
+class InputQueue final {
+public:
+  InputQueue(void) NOEXCEPT;
+
+  void Push(InputEvent const& event) NOEXCEPT;
+
+  inline void PushKey(int key, int action) NOEXCEPT {
+    Push({ glfwGetTimerValue(), InputType::Key, key, action, 0.0, 0.0 });
+  }
+
+  inline void PushMouse(double x, double y) NOEXCEPT {
+    Push({ glfwGetTimerValue(), InputType::Mouse, 0, 0, x, y });
+  }
+
+  inline void PushScroll(double x, double y) NOEXCEPT {
+    Push({ glfwGetTimerValue(), InputType::Scroll, 0, 0, x, y });
+  }
+
+  ///
+  /// Call `function(event)` for each event in order, the key table is
+  /// updated after each call: `Pressed()` is the state before the event.
+  ///
+  template <typename Function>
+  void Drain(Function&& function) NOEXCEPT {
+    for (; m_tail != m_head; ++m_tail) {
+      InputEvent const& event = m_events[m_tail % TR_INPUT_CAPACITY];
+      function(event);
+
+      if (event.type == InputType::Key && event.key >= 0 && event.key <= GLFW_KEY_LAST) {
+        m_keys[static_cast<size_t>(event.key)] = event.action != GLFW_RELEASE;
+      }
+    }
+  }
+
+  inline bool Pressed(int key) const NOEXCEPT {
+    return key >= 0 && key <= GLFW_KEY_LAST && m_keys[static_cast<size_t>(key)];
+  }
+
+  inline double Seconds(uint64_t ticks) const NOEXCEPT {
+    return static_cast<double>(ticks - m_base) / m_frequency;
+  }
+
+  inline double Now(void) const NOEXCEPT {
+    return Seconds(glfwGetTimerValue());
+  }
+
+  constexpr size_t Dropped(void) const NOEXCEPT { return m_dropped; }
+
+private:
+  TR_DELETE_COPY_CTOR(InputQueue);
+  TR_DELETE_MOVE_CTOR(InputQueue);
+
+  std::array<InputEvent, TR_INPUT_CAPACITY> m_events;
+  size_t m_head = 0u, m_tail = 0u; // Monotonic
+  size_t m_dropped = 0u;
+
+  std::bitset<GLFW_KEY_LAST + 1> m_keys; // Pressed, as of the last drained event
+  uint64_t m_base;
+  double m_frequency;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_INPUT_QUEUE_HPP
@@ -1,100 +1,410 @@
 #include "imgui/imgui.h"
 
-#include <cstdarg> // va_list(), va_start(), va_end()
-#include <cstdio> // fprintf(), FILE
+#include <atomic> // std::atomic{}
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstddef> // size_t
+#include <cstdint> // int64_t, intptr_t, uint64_t
+#include <cinttypes> // PRIu64
+#include <cstdio> // fwrite(), fflush(), fopen(), FILE
+#include <cstring> // memcpy()
+#include <deque> // std::deque{}
+#include <filesystem> // std::filesystem::create_directories()
+#include <memory> // std::unique_ptr{}
+#include <mutex> // std::mutex{}, std::lock_guard{}
+#include <stop_token> // std::stop_token{}
 #include <string_view> // std::string_view{}
+#include <system_error> // std::error_code{}
+#include <thread> // std::jthread{}, std::this_thread::sleep_for()
 
 #include "Log.hpp" // TR_LOG()
 
 TR_BEGIN_NAMESPACE()
 
+static_assert(sizeof(LogRecord) == TR_LOG_RECORD_SIZE);
+static_assert((TR_LOG_CAPACITY & (TR_LOG_CAPACITY - 1u)) == 0u);
+
+#define TR_LOG_LINE_SIZE 1024 // Formatted message, truncated beyond
+#define TR_LOG_BUDGET (1u << 20) // Bytes of text kept for the window
+#define TR_LOG_LINES (1u << 14) // Lines kept for the window
+#define TR_LOG_IDLE_MS 2 // Consumer sleep when the ring is empty
+
+///
+/// Multiple producers, single consumer.
+///
+/// Producers claim records with a CAS on `m_head` and publish them through
+/// the per-record sequence number (Dmitry Vyukov's bounded queue), they never
+/// block nor allocate. The consumer thread formats the records in order,
+/// writes them to the console and appends them to the window buffer (guarded
+/// by a mutex shared with `Render()` only).
+///
+/// The window keeps a fixed budget of text and lines, both rings: the oldest
+/// lines are evicted (and optionally spilled to a file). The filter results
+/// are indexed as lines arrive, so each line is tested once.
+///
 class Log {
 public:
-  enum class Level { ERROR, WARNING, DEBUG, INFO };
-  static std::string_view LevelName(Level level) NOEXCEPT;
+  static std::string_view LevelName(LogLevel level) NOEXCEPT;
 
 public:
   Log(void) NOEXCEPT;
+  ~Log(void) NOEXCEPT;
 
-  void Clear(void) NOEXCEPT;
-  void Write(Level level, const char* format, va_list args) NOEXCEPT TR_FMTLIST(3);
+  LogRecord* Acquire(LogLevel level, char const* format, LogDecoder decoder) NOEXCEPT;
+  void Commit(LogRecord* record) NOEXCEPT;
+  void Flush(void) NOEXCEPT;
+
+  inline size_t Dropped(void) const NOEXCEPT {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  inline void SetConsole(bool enabled) NOEXCEPT {
+    m_console.store(enabled, std::memory_order_relaxed);
+  }
 
-  void RenderLine(char const* start, char const* end) NOEXCEPT;
+  void Clear(void) NOEXCEPT;
   void Render(char const* title, bool* open = NULL) NOEXCEPT;
 
 private:
+  void Consume(std::stop_token token) NOEXCEPT;
+  bool ConsumeOne(void) NOEXCEPT;
+  void Write(LogLevel level, int64_t time, char const* message, size_t size) NOEXCEPT;
+
+  struct Line {
+    uint64_t offset; // Monotonic, modulo TR_LOG_BUDGET in `m_text`
+    uint32_t size; // Without '\n'
+    LogLevel level;
+  };
+
+  // Storage, guarded by `m_mutex`.
+  void Append(LogLevel level, char const* text, size_t size) NOEXCEPT;
+  void Evict(void) NOEXCEPT;
+  void SetSpill(bool spill) NOEXCEPT;
+
+  inline Line const& GetLine(uint64_t line) const NOEXCEPT {
+    return m_lines[line % TR_LOG_LINES];
+  }
+
+  inline char const* LineText(Line const& line) const NOEXCEPT {
+    return m_text.get() + line.offset % TR_LOG_BUDGET;
+  }
+
+  void RenderLine(Line const& line) NOEXCEPT;
+
+  std::chrono::steady_clock::time_point m_start;
+  std::unique_ptr<LogRecord[]> m_records;
+  alignas(64) std::atomic<size_t> m_head{0u}; // Next record to claim
+  alignas(64) std::atomic<size_t> m_tail{0u}; // Next record to consume
+  std::atomic<size_t> m_dropped{0u};
+  std::atomic<bool> m_console{true};
+  size_t m_droppedReported = 0u; // Consumer only
+
+  std::mutex m_mutex; // Window storage (consumer/Render)
+  std::unique_ptr<char[]> m_text; // TR_LOG_BUDGET bytes
+  std::unique_ptr<Line[]> m_lines; // TR_LOG_LINES lines
+  uint64_t m_textEnd = 0u;
+  uint64_t m_firstLine = 0u, m_endLine = 0u; // Monotonic line numbers
+  FILE* m_spill = NULL; // Evicted lines are appended to it
+
   bool m_autoScroll = true;
-  ImGuiTextBuffer m_buffer;
+  LogLevel m_level = LogLevel::TRACE; // Displayed up to
   ImGuiTextFilter m_filter;
-  ImVector<int> m_lineOffsets;
+  std::deque<uint64_t> m_filtered; // Lines passing `m_level` and `m_filter`
+  uint64_t m_filteredEnd = 0u; // First line not tested yet
+
+  std::jthread m_consumer; // Last: joined before the ring is released
 };
 
-static Log s_log;
+// Constant-initialised, before any module registers itself.
+static constinit LogModule* s_modules = NULL;
 
-void GlobalLogRender(char const* title, bool* open) NOEXCEPT {
-  s_log.Render(title, open);
+LogModule::LogModule(char const* file) NOEXCEPT
+  : name(file), level(static_cast<LogLevel>(TR_LOG_LEVEL)), next(s_modules)
+{
+  // __BASE_FILE__ is a path, keep the file name.
+  for (char const* c = file; *c != '\0'; ++c) {
+    if (*c == '/' || *c == '\\') name = c + 1;
+  }
+  s_modules = this;
+}
+
+LogModule* LogModules(void) NOEXCEPT {
+  return s_modules;
+}
+
+static char const* s_levelNames[] = { "Error", "Warning", "Info", "Debug", "Trace" };
+
+/// Constructed on first use (logging from static constructors is allowed).
+static Log& GlobalLogInstance(void) NOEXCEPT {
+  static Log s_log;
+  return s_log;
+}
+
+LogRecord* LogAcquire(LogLevel level, char const* format, LogDecoder decoder) NOEXCEPT {
+  return GlobalLogInstance().Acquire(level, format, decoder);
+}
+
+void LogCommit(LogRecord* record) NOEXCEPT {
+  GlobalLogInstance().Commit(record);
 }
 
-void GlobalLog(FILE* stream, char const* format, ...) NOEXCEPT {
-  va_list args;
+void GlobalLogFlush(void) NOEXCEPT {
+  GlobalLogInstance().Flush();
+}
 
-  va_start(args, format);
-  vfprintf(stream, format, args);
-  va_end(args);
+size_t GlobalLogDropped(void) NOEXCEPT {
+  return GlobalLogInstance().Dropped();
+}
 
-  Log::Level level = stream == stderr ? Log::Level::ERROR : Log::Level::INFO;
+void GlobalLogConsole(bool enabled) NOEXCEPT {
+  GlobalLogInstance().SetConsole(enabled);
+}
 
-  va_start(args, format);
-  s_log.Write(level, format, args);
-  va_end(args);
+void GlobalLogRender(char const* title, bool* open) NOEXCEPT {
+  GlobalLogInstance().Render(title, open);
 }
 
-std::string_view Log::LevelName(Level level) NOEXCEPT {
+std::string_view Log::LevelName(LogLevel level) NOEXCEPT {
   switch (level) {
-    case Level::ERROR:   return "Error";
-    case Level::WARNING: return "Warning";
-    case Level::DEBUG:   return "Debug";
-    case Level::INFO:    return "Info";
-    default:             return "??";
+    case LogLevel::ERROR:   return "Error";
+    case LogLevel::WARNING: return "Warning";
+    case LogLevel::INFO:    return "Info";
+    case LogLevel::DEBUG:   return "Debug";
+    case LogLevel::TRACE:   return "Trace";
+    default:                return "??";
   }
 }
 
-Log::Log(void) NOEXCEPT {
-  Clear();
+Log::Log(void) NOEXCEPT
+  : m_start(std::chrono::steady_clock::now())
+  , m_records(new LogRecord[TR_LOG_CAPACITY])
+  , m_text(new char[TR_LOG_BUDGET])
+  , m_lines(new Line[TR_LOG_LINES])
+{
+  for (size_t i = 0u; i < TR_LOG_CAPACITY; ++i) {
+    m_records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  m_consumer = std::jthread([this](std::stop_token token) { Consume(token); });
 }
 
-void Log::Clear(void) NOEXCEPT {
-  m_buffer.clear();
-  m_lineOffsets.clear();
-  m_lineOffsets.push_back(0);
-}
-
-void Log::Write(Log::Level level, const char* format, va_list args) NOEXCEPT {
-  int oldSize = m_buffer.size();
-  // TODO: Add time before log level.
-  std::string_view name = LevelName(level);
-  int nameSize = static_cast<int>(name.size());
-  m_buffer.appendf("[%*.*s] ", nameSize, nameSize, name.data());
-  m_buffer.appendfv(format, args);
-  for (int newSize = m_buffer.size(); oldSize < newSize; ++oldSize) {
-    if (m_buffer[oldSize] == '\n') {
-      m_lineOffsets.push_back(oldSize + 1);
+Log::~Log(void) NOEXCEPT {
+  // Drain what is left before the ring goes away.
+  m_consumer.request_stop();
+  m_consumer.join();
+
+  // The spill file gets the lines still in memory too.
+  if (m_spill != NULL) {
+    while (m_firstLine < m_endLine) Evict();
+    SetSpill(false);
+  }
+}
+
+// ╔═╗┬─┐┌─┐┌┬┐┬ ┬┌─┐┌─┐┬─┐┌─┐
+// ╠═╝├┬┘│ │ │││ ││  ├┤ ├┬┘└─┐
+// ╩  ┴└─└─┘─┴┘└─┘└─┘└─┘┴└─└─┘
+
+LogRecord* Log::Acquire(LogLevel level, char const* format, LogDecoder decoder) NOEXCEPT {
+  size_t position = m_head.load(std::memory_order_relaxed);
+  LogRecord* record;
+
+  for (;;) {
+    record = &m_records[position & (TR_LOG_CAPACITY - 1u)];
+    size_t sequence = record->sequence.load(std::memory_order_acquire);
+    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+    if (difference == 0) {
+      // Free, claim it (`position` is reloaded on failure).
+      if (m_head.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed)) break;
+    }
+    else if (difference < 0) {
+      // Not consumed yet: the ring is full.
+      m_dropped.fetch_add(1u, std::memory_order_relaxed);
+      return NULL;
+    }
+    else {
+      // Claimed by another producer meanwhile.
+      position = m_head.load(std::memory_order_relaxed);
     }
   }
+
+  record->position = position;
+  record->time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - m_start
+  ).count();
+  record->level = level;
+  record->format = format;
+  record->decoder = decoder;
+  return record;
 }
 
-void Log::RenderLine(char const* start, char const* end) NOEXCEPT {
-  if (start[0] == '[') {
-    std::string_view line(start + 1, end);
-    if (line.starts_with(LevelName(Log::Level::ERROR))) {
-      ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0, 0.0, 0.0, 1.0));
-      ImGui::TextUnformatted(start, end);
-      ImGui::PopStyleColor();
-      return;
+void Log::Commit(LogRecord* record) NOEXCEPT {
+  record->sequence.store(record->position + 1u, std::memory_order_release);
+}
+
+void Log::Flush(void) NOEXCEPT {
+  size_t head = m_head.load(std::memory_order_acquire);
+  while (m_tail.load(std::memory_order_acquire) < head) {
+    std::this_thread::yield();
+  }
+}
+
+// ╔═╗┌─┐┌┐┌┌─┐┬ ┬┌┬┐┌─┐┬─┐
+// ║  │ ││││└─┐│ ││││├┤ ├┬┘
+// ╚═╝└─┘┘└┘└─┘└─┘┴ ┴└─┘┴└─
+
+void Log::Consume(std::stop_token token) NOEXCEPT {
+  while (!token.stop_requested()) {
+    if (!ConsumeOne()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(TR_LOG_IDLE_MS));
+    }
+  }
+
+  while (ConsumeOne());
+  fflush(stdout);
+  fflush(stderr);
+}
+
+bool Log::ConsumeOne(void) NOEXCEPT {
+  size_t dropped = m_dropped.load(std::memory_order_relaxed);
+  if (dropped != m_droppedReported) {
+    char message[64];
+    int size = snprintf(message, sizeof(message), "%zu messages dropped (log ring full)\n", dropped - m_droppedReported);
+    Write(LogLevel::WARNING, -1, message, static_cast<size_t>(size));
+    m_droppedReported = dropped;
+  }
+
+  size_t position = m_tail.load(std::memory_order_relaxed);
+  LogRecord& record = m_records[position & (TR_LOG_CAPACITY - 1u)];
+  if (record.sequence.load(std::memory_order_acquire) != position + 1u) {
+    return false; // Empty (or still being written)
+  }
+
+  char message[TR_LOG_LINE_SIZE];
+  int size = record.decoder(message, sizeof(message), record.format, record.arguments);
+  size = TR_CLAMP(size, 0, static_cast<int>(sizeof(message)) - 1);
+  if (size == static_cast<int>(sizeof(message)) - 1) message[size - 1] = '\n'; // Truncated
+  Write(record.level, record.time, message, static_cast<size_t>(size));
+
+  // Hand the record back to the producers.
+  record.sequence.store(position + TR_LOG_CAPACITY, std::memory_order_release);
+  m_tail.store(position + 1u, std::memory_order_release);
+  return true;
+}
+
+void Log::Write(LogLevel level, int64_t time, char const* message, size_t size) NOEXCEPT {
+  // printk()-like timestamp: "[    1.234567] ".
+  char prefix[32];
+  if (time < 0) time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+  int prefixSize = snprintf(prefix, sizeof(prefix), "[%5lld.%06lld] ",
+    static_cast<long long>(time / 1000000000), static_cast<long long>(time % 1000000000 / 1000));
+
+  // Errors and warnings to stderr, everything else to stdout.
+  if (m_console.load(std::memory_order_relaxed)) {
+    FILE* stream = level == LogLevel::ERROR || level == LogLevel::WARNING ? stderr : stdout;
+    fwrite(prefix, 1u, static_cast<size_t>(prefixSize), stream);
+    fwrite(message, 1u, size, stream);
+  }
+
+  // One entry per line, the timestamp is only on the first one.
+  char line[TR_LOG_LINE_SIZE + sizeof(prefix)];
+  memcpy(line, prefix, static_cast<size_t>(prefixSize));
+  size_t lineSize = static_cast<size_t>(prefixSize);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (char const* c = message, *end = message + size; c < end; ++c) {
+    if (*c != '\n') {
+      line[lineSize++] = *c;
+      continue;
     }
+    Append(level, line, lineSize);
+    lineSize = 0u;
+  }
+  if (lineSize > 0u) Append(level, line, lineSize);
+}
+
+// ╔═╗┌┬┐┌─┐┬─┐┌─┐┌─┐┌─┐
+// ╚═╗ │ │ │├┬┘├─┤│ ┬├┤
+// ╚═╝ ┴ └─┘┴└─┴ ┴└─┘└─┘
+
+void Log::Append(LogLevel level, char const* text, size_t size) NOEXCEPT {
+  // Lines are contiguous: skip the end of the buffer when it does not fit.
+  uint64_t offset = m_textEnd;
+  if (offset % TR_LOG_BUDGET + size > TR_LOG_BUDGET) {
+    offset += TR_LOG_BUDGET - offset % TR_LOG_BUDGET;
+  }
+
+  // Evict the oldest lines until both the text and the line count fit.
+  while (m_firstLine < m_endLine && (
+    m_endLine - m_firstLine == TR_LOG_LINES ||
+    offset + size - GetLine(m_firstLine).offset > TR_LOG_BUDGET
+  )) {
+    Evict();
+  }
+  if (m_firstLine == m_endLine) {
+    offset = 0u; // Empty: restart from the beginning (and keep offsets small)
+  }
+
+  memcpy(m_text.get() + offset % TR_LOG_BUDGET, text, size);
+  m_lines[m_endLine % TR_LOG_LINES] = { offset, static_cast<uint32_t>(size), level };
+  m_endLine += 1u;
+  m_textEnd = offset + size;
+}
+
+void Log::Evict(void) NOEXCEPT {
+  if (m_spill != NULL) {
+    Line const& line = GetLine(m_firstLine);
+    fwrite(LineText(line), 1u, line.size, m_spill);
+    fputc('\n', m_spill);
+  }
+
+  m_firstLine += 1u;
+  while (!m_filtered.empty() && m_filtered.front() < m_firstLine) {
+    m_filtered.pop_front();
+  }
+  m_filteredEnd = TR_MAX(m_filteredEnd, m_firstLine);
+}
+
+void Log::SetSpill(bool spill) NOEXCEPT {
+  if (spill == (m_spill != NULL)) return;
+
+  if (spill) {
+    std::error_code error;
+    std::filesystem::create_directories(TR_BUILD_DIR "/logs", error);
+    m_spill = fopen(TR_BUILD_DIR "/logs/log.txt", "a");
+  }
+  else {
+    fclose(m_spill);
+    m_spill = NULL;
+  }
+}
+
+void Log::Clear(void) NOEXCEPT {
+  m_firstLine = m_endLine;
+  m_filtered.clear();
+  m_filteredEnd = m_endLine;
+}
+
+// ╦ ╦┬┌┐┌┌┬┐┌─┐┬ ┬
+// ║║║││││ │││ ││││
+// ╚╩╝┴┘└┘─┴┘└─┘└┴┘
+
+void Log::RenderLine(Line const& line) NOEXCEPT {
+  char const* start = LineText(line);
+
+  ImVec4 color;
+  switch (line.level) {
+    case LogLevel::ERROR:   color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f); break;
+    case LogLevel::WARNING: color = ImVec4(1.0f, 0.8f, 0.0f, 1.0f); break;
+    case LogLevel::DEBUG:
+    case LogLevel::TRACE:   color = ImGui::GetStyle().Colors[ImGuiCol_TextDisabled]; break;
+    default:
+      ImGui::TextUnformatted(start, start + line.size);
+      return;
   }
 
-  ImGui::TextUnformatted(start, end);
+  ImGui::PushStyleColor(ImGuiCol_Text, color);
+  ImGui::TextUnformatted(start, start + line.size);
+  ImGui::PopStyleColor();
 }
 
 // Everything is taked (and improved) from ImGui Demo.
@@ -104,8 +414,31 @@ void Log::Render(char const* title, bool* open) NOEXCEPT {
     return;
   }
 
+  // The consumer thread appends concurrently.
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   if (ImGui::BeginPopup("Options")) {
     ImGui::Checkbox("Auto-scroll", &m_autoScroll);
+    bool spill = m_spill != NULL;
+    if (ImGui::Checkbox("Spill to " TR_BUILD_DIR "/logs/log.txt", &spill)) {
+      SetSpill(spill);
+    }
+    ImGui::Text("%" PRIu64 " lines, %" PRIu64 " / %u KiB",
+      m_endLine - m_firstLine,
+      m_firstLine < m_endLine ? (m_textEnd - GetLine(m_firstLine).offset) / 1024u : 0u,
+      TR_LOG_BUDGET / 1024u);
+    ImGui::EndPopup();
+  }
+
+  if (ImGui::BeginPopup("Modules")) {
+    // Runtime thresholds, messages above are not even recorded.
+    for (LogModule* module = LogModules(); module != NULL; module = module->next) {
+      int level = static_cast<int>(module->level.load(std::memory_order_relaxed));
+      ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+      if (ImGui::Combo(module->name, &level, s_levelNames, TR_LOG_LEVEL + 1)) {
+        module->level.store(static_cast<LogLevel>(level), std::memory_order_relaxed);
+      }
+    }
     ImGui::EndPopup();
   }
 
@@ -113,52 +446,56 @@ void Log::Render(char const* title, bool* open) NOEXCEPT {
     ImGui::OpenPopup("Options");
   }
 
+  ImGui::SameLine(); if (ImGui::Button("Modules")) ImGui::OpenPopup("Modules");
   ImGui::SameLine(); bool clear = ImGui::Button("Clear");
-  ImGui::SameLine(); m_filter.Draw("Filter", 400.0f);
+
+  // Displayed levels (up to the selected one).
+  int level = static_cast<int>(m_level);
+  ImGui::SameLine(); ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+  bool filterChanged = ImGui::Combo("Level", &level, s_levelNames, static_cast<int>(TR_ARRAYSIZE(s_levelNames)));
+  m_level = static_cast<LogLevel>(level);
+
+  ImGui::SameLine(); filterChanged |= m_filter.Draw("Filter", 400.0f);
+  if (size_t dropped = Dropped()) {
+    ImGui::SameLine(); ImGui::TextDisabled("(%zu dropped)", dropped);
+  }
   ImGui::Separator();
 
+  if (clear) Clear();
+
+  // Only test the lines appended since the last frame.
+  if (filterChanged) {
+    m_filtered.clear();
+    m_filteredEnd = m_firstLine;
+  }
+  bool filtered = m_filter.IsActive() || m_level != LogLevel::TRACE;
+  if (filtered) {
+    for (; m_filteredEnd < m_endLine; ++m_filteredEnd) {
+      Line const& line = GetLine(m_filteredEnd);
+      char const* start = LineText(line);
+      if (line.level <= m_level && m_filter.PassFilter(start, start + line.size)) {
+        m_filtered.push_back(m_filteredEnd);
+      }
+    }
+  }
+
   ImGuiChildFlags childFlags = ImGuiChildFlags_None;;
   ImGuiWindowFlags windowFlags = ImGuiWindowFlags_HorizontalScrollbar;
   ImGui::PushStyleColor(ImGuiCol_ChildBg, ImGui::GetStyle().Colors[ImGuiCol_FrameBg]);
   if (ImGui::BeginChild("Scrolling", ImVec2(0, 0), childFlags, windowFlags)) {
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
     // if (copy) ImGui::LogToClipboard(); ??
-    if (clear) Clear();
-
-    char const* bufferStart = m_buffer.begin();
-    char const* bufferEnd = m_buffer.end();
-
-    if (m_filter.IsActive()) {
-      for (int lineNumber = 0; lineNumber < m_lineOffsets.Size; ++lineNumber) {
-        char const* lineStart = bufferStart + m_lineOffsets[lineNumber];
-        const char* lineEnd = (lineNumber + 1 < m_lineOffsets.Size)
-          ? (bufferStart + m_lineOffsets[lineNumber + 1] - 1)
-          : bufferEnd;
 
-        if (m_filter.PassFilter(lineStart, lineEnd)) {
-          RenderLine(lineStart, lineEnd);
-        }
-      }
-    }
-    else {
-      // If you have tens of thousands of items and their processing cost is
-      // non-negligible, clipping them is recommended. Using ImGuiListClipper
-      // requires: A) random access into your data; B) items all being the same
-      // height. Otherwise, use ImGui::TextUnformatted(bufferStart, bufferEnd).
-      ImGuiListClipper clipper;
-      clipper.Begin(m_lineOffsets.Size);
-      while (clipper.Step()) {
-        for (int lineNumber = clipper.DisplayStart; lineNumber < clipper.DisplayEnd; ++lineNumber) {
-          char const* lineStart = bufferStart + m_lineOffsets[lineNumber];
-          const char* lineEnd = (lineNumber + 1 < m_lineOffsets.Size)
-            ? (bufferStart + m_lineOffsets[lineNumber + 1] - 1)
-            : bufferEnd;
-
-          RenderLine(lineStart, lineEnd);
-        }
+    // Lines all have the same height: clip in both modes.
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(filtered ? m_filtered.size() : m_endLine - m_firstLine));
+    while (clipper.Step()) {
+      for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+        size_t index = static_cast<size_t>(row);
+        RenderLine(GetLine(filtered ? m_filtered[index] : m_firstLine + index));
       }
-      clipper.End();
     }
+    clipper.End();
 
     ImGui::PopStyleVar();
     if (m_autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
@@ -1,26 +1,290 @@
 #ifndef TR_LOG_HPP
 #define TR_LOG_HPP
 
-#include <cstdio> // FILE
+#include <atomic> // std::atomic{}
+#include <cstddef> // size_t, std::byte{}
+#include <cstdint> // int64_t, uint16_t, uint32_t
+#include <cstdio> // snprintf()
+#include <cstring> // memcpy(), strnlen()
+#include <string_view> // std::string_view{}
+#include <tuple> // std::tuple{}, std::apply()
+#include <type_traits> // std::is_same_v, std::is_integral_v, ...
+
 #include "helper.hpp" // TR_FMTARGS()
 
 TR_BEGIN_NAMESPACE()
 
+// printk()-like levels, the lower the more severe.
+#define TR_LOG_LEVEL_ERROR   0
+#define TR_LOG_LEVEL_WARNING 1
+#define TR_LOG_LEVEL_INFO    2
+#define TR_LOG_LEVEL_DEBUG   3
+#define TR_LOG_LEVEL_TRACE   4
+
+///
+/// Build-time threshold (`-D TR_LOG_LEVEL=N`, see `make LOG_LEVEL=N`), less
+/// severe levels compile to nothing (the format is still checked).
+///
+#ifndef TR_LOG_LEVEL
+#ifdef NDEBUG
+#define TR_LOG_LEVEL TR_LOG_LEVEL_INFO
+#else
+#define TR_LOG_LEVEL TR_LOG_LEVEL_TRACE
+#endif
+#endif
+
+enum class LogLevel: uint32_t {
+  ERROR   = TR_LOG_LEVEL_ERROR,
+  WARNING = TR_LOG_LEVEL_WARNING,
+  INFO    = TR_LOG_LEVEL_INFO,
+  DEBUG   = TR_LOG_LEVEL_DEBUG,
+  TRACE   = TR_LOG_LEVEL_TRACE,
+};
+
+#define TR_LOG_RECORD_SIZE 256u // Bytes per record (arguments included)
+#define TR_LOG_CAPACITY 4096u // Records in the ring, a power of two
+
+///
+/// Format string scanned at compile-time.
+///
+/// Arguments are formatted later on the consumer thread, so strings are
+/// copied into the record: `%.*s` strings are bounded by their precision
+/// (they may not be null-terminated), `bounded` flags them by index.
+///
+struct LogFormat {
+  char const* format;
+  uint32_t bounded = 0u;
+
+  consteval LogFormat(char const* string) NOEXCEPT : format(string) {
+    uint32_t argument = 0u;
+    for (char const* c = string; *c != '\0'; ++c) {
+      if (*c != '%') continue;
+      if (*++c == '%') continue;
+
+      bool precision = false;
+      for (; *c != '\0' && std::string_view("-+ #0123456789.*hljztL").find(*c) != std::string_view::npos; ++c) {
+        if (*c == '*') {
+          precision = c[-1] == '.';
+          argument += 1u;
+        }
+      }
+      if (*c == 's' && precision && argument < 32u) bounded |= 1u << argument;
+      if (*c == '\0') break;
+      argument += 1u;
+    }
+  }
+};
+
+using LogDecoder = int (*)(char* output, size_t size, char const* format, std::byte const* arguments);
+
+///
+/// Slot of the log ring, the message is not formatted: the format pointer and
+/// the raw arguments are stored, `decoder` formats them on the consumer.
+///
+struct alignas(64) LogRecord {
+  std::atomic<size_t> sequence;
+  size_t position;
+  int64_t time; // Nanoseconds (steady clock) since the logger started
+  LogLevel level;
+  char const* format;
+  LogDecoder decoder;
+  std::byte arguments[TR_LOG_RECORD_SIZE - 48u];
+};
+
+/// Reserve the next record (lock-free), NULL when the ring is full: the
+/// message is dropped and counted.
+LogRecord* LogAcquire(LogLevel level, char const* format, LogDecoder decoder) NOEXCEPT;
+/// Publish a record filled after `LogAcquire()`.
+void LogCommit(LogRecord* record) NOEXCEPT;
+
+template <typename T>
+constexpr bool LogIsString = std::is_same_v<T, char const*> || std::is_same_v<T, char*>;
+
+/// Type stored in a record (and handed back to `snprintf()`).
+template <typename T>
+using LogStored = std::conditional_t<LogIsString<T>, char const*, T>;
+
+/// Bytes always reserved for an argument (a string stores its length and
+/// the null terminator, its characters use what is left).
+template <typename T>
+constexpr size_t LogFixedSize = LogIsString<T> ? sizeof(uint16_t) + 1u : sizeof(T);
+
+#define TR_LOG_NULL_STRING 0xFFFFu
+
+class LogWriter final {
+public:
+  constexpr LogWriter(std::byte* data, size_t size, uint32_t bounded, size_t reserved) NOEXCEPT
+    : m_data(data), m_size(size), m_reserved(reserved), m_bounded(bounded) {}
+
+  template <typename T>
+  inline void Put(T value) NOEXCEPT {
+    static_assert(std::is_trivially_copyable_v<T>, "Log arguments are copied raw.");
+    m_reserved -= LogFixedSize<T>;
+
+    if constexpr (LogIsString<T>) {
+      size_t capacity = m_size - m_used - m_reserved - LogFixedSize<T>;
+      if ((m_bounded >> m_index) & 1u) capacity = TR_MIN(capacity, static_cast<size_t>(TR_MAX(m_precision, 0)));
+
+      uint16_t length = TR_LOG_NULL_STRING;
+      if (value != NULL) length = static_cast<uint16_t>(strnlen(value, TR_MIN(capacity, TR_LOG_NULL_STRING - 1u)));
+      Write(&length, sizeof(length));
+      if (value != NULL) Write(value, length);
+      m_data[m_used++] = std::byte{0};
+    }
+    else {
+      if constexpr (std::is_same_v<T, int>) m_precision = value;
+      Write(&value, sizeof(value));
+    }
+
+    m_index += 1u;
+  }
+
+private:
+  inline void Write(void const* source, size_t size) NOEXCEPT {
+    memcpy(m_data + m_used, source, size);
+    m_used += size;
+  }
+
+  std::byte* m_data;
+  size_t m_size, m_used = 0u;
+  size_t m_reserved; // Fixed bytes of the arguments left to write
+  uint32_t m_bounded, m_index = 0u;
+  int m_precision = -1; // Last `int` argument (`%.*s`)
+};
+
+class LogReader final {
+public:
+  constexpr LogReader(std::byte const* data) NOEXCEPT : m_data(data) {}
+
+  template <typename T>
+  inline T Get(void) NOEXCEPT {
+    if constexpr (LogIsString<T>) {
+      uint16_t length;
+      memcpy(&length, m_data, sizeof(length));
+      char const* string = reinterpret_cast<char const*>(m_data + sizeof(length));
+      m_data += sizeof(length) + (length == TR_LOG_NULL_STRING ? 0u : length) + 1u;
+      return length == TR_LOG_NULL_STRING ? NULL : string;
+    }
+    else {
+      T value;
+      memcpy(&value, m_data, sizeof(value));
+      m_data += sizeof(value);
+      return value;
+    }
+  }
+
+private:
+  std::byte const* m_data;
+};
+
+template <typename... Args>
+int LogDecode(char* output, size_t size, char const* format, std::byte const* arguments) NOEXCEPT {
+  LogReader reader(arguments);
+  std::tuple<Args...> values{ reader.Get<Args>()... }; // Braced: read in order
+  return std::apply([&](Args... args) { return snprintf(output, size, format, args...); }, values);
+}
+
+///
+/// Asynchronous `printf()`-like logging, safe from any thread.
+///
+/// The caller only copies the arguments into a lock-free ring (tens of
+/// nanoseconds), a background thread formats and routes them to the console
+/// (errors and warnings to `stderr`) and to the log window.
+///
+template <typename... Args>
+void GlobalLog(LogLevel level, LogFormat format, Args... args) NOEXCEPT {
+  static_assert((0u + ... + LogFixedSize<LogStored<Args>>) <= sizeof(LogRecord::arguments), "Too many log arguments.");
+
+  LogRecord* record = LogAcquire(level, format.format, &LogDecode<LogStored<Args>...>);
+  if (record == NULL) return;
+
+  LogWriter writer(record->arguments, sizeof(record->arguments), format.bounded, (0u + ... + LogFixedSize<LogStored<Args>>));
+  (writer.Put(static_cast<LogStored<Args>>(args)), ...);
+  LogCommit(record);
+}
+
+///
+/// Runtime threshold of a module (a translation unit by default, or
+/// `#define TR_LOG_MODULE "Name"` before including this header).
+///
+/// Modules link themselves at static initialisation, the log window lists
+/// them. Filtering a message costs one load and one branch.
+///
+struct LogModule {
+  char const* name;
+  std::atomic<LogLevel> level;
+  LogModule* next;
+
+  explicit LogModule(char const* name) NOEXCEPT;
+};
+
+/// First registered module (then follow `next`).
+LogModule* LogModules(void) NOEXCEPT;
+
+#ifndef TR_LOG_MODULE
+#define TR_LOG_MODULE __BASE_FILE__
+#endif
+
+static LogModule s_logModule(TR_LOG_MODULE);
+
+/// Never called, only lets the compiler check formats against arguments.
+inline void GlobalLogCheck(char const* format, ...) NOEXCEPT TR_FMTARGS(1);
+inline void GlobalLogCheck(char const*, ...) NOEXCEPT {}
+
+/// Block until every message logged so far has been written.
+void GlobalLogFlush(void) NOEXCEPT;
+/// Messages dropped because the ring was full.
+size_t GlobalLogDropped(void) NOEXCEPT;
+/// Echo messages to `stdout`/`stderr` (default), the window keeps them.
+void GlobalLogConsole(bool enabled) NOEXCEPT;
+
 /// Render logs into an ImGui window.
 void GlobalLogRender(char const* title, bool* open = NULL) NOEXCEPT;
-void GlobalLog(FILE* stream, char const* format, ...) NOEXCEPT TR_FMTARGS(2);
 
 // __FILE_NAME__ is not standard.
 // https://gcc.gnu.org/onlinedocs/cpp/Common-Predefined-Macros.html
 // https://gcc.gnu.org/onlinedocs/cpp/Standard-Predefined-Macros.html
-#define TR_FPRINTF(STREAM, FORMAT, ...)                             \
-  GlobalLog(STREAM,                                                 \
-    __FILE_NAME__ ":%s():" TR_STRINGIFY(__LINE__) ": " FORMAT "\n", \
-    __func__, ##__VA_ARGS__                                         \
-  )
-
-#define TR_DEBUG(FORMAT, ...) TR_FPRINTF(stdout, FORMAT, ##__VA_ARGS__)
-#define TR_ERROR(FORMAT, ...) TR_FPRINTF(stderr, FORMAT, ##__VA_ARGS__)
+#define TR_LOG_FORMAT(FORMAT) __FILE_NAME__ ":%s():" TR_STRINGIFY(__LINE__) ": " FORMAT "\n"
+
+#define TR_LOG(LEVEL, FORMAT, ...)                                            \
+  do {                                                                        \
+    if (false) GlobalLogCheck(TR_LOG_FORMAT(FORMAT), __func__, ##__VA_ARGS__); \
+    if ((LEVEL) <= s_logModule.level.load(std::memory_order_relaxed)) {       \
+      GlobalLog(LEVEL, TR_LOG_FORMAT(FORMAT), __func__, ##__VA_ARGS__);       \
+    }                                                                         \
+  } while (0)
+
+/// Compiled out, the format is still checked.
+#define TR_LOG_NOTHING(FORMAT, ...)                                           \
+  do {                                                                        \
+    if (false) GlobalLogCheck(TR_LOG_FORMAT(FORMAT), __func__, ##__VA_ARGS__); \
+  } while (0)
+
+#define TR_ERROR(FORMAT, ...) TR_LOG(LogLevel::ERROR, FORMAT, ##__VA_ARGS__)
+
+#if TR_LOG_LEVEL >= TR_LOG_LEVEL_WARNING
+#define TR_WARNING(FORMAT, ...) TR_LOG(LogLevel::WARNING, FORMAT, ##__VA_ARGS__)
+#else
+#define TR_WARNING(FORMAT, ...) TR_LOG_NOTHING(FORMAT, ##__VA_ARGS__)
+#endif
+
+#if TR_LOG_LEVEL >= TR_LOG_LEVEL_INFO
+#define TR_INFO(FORMAT, ...) TR_LOG(LogLevel::INFO, FORMAT, ##__VA_ARGS__)
+#else
+#define TR_INFO(FORMAT, ...) TR_LOG_NOTHING(FORMAT, ##__VA_ARGS__)
+#endif
+
+#if TR_LOG_LEVEL >= TR_LOG_LEVEL_DEBUG
+#define TR_DEBUG(FORMAT, ...) TR_LOG(LogLevel::DEBUG, FORMAT, ##__VA_ARGS__)
+#else
+#define TR_DEBUG(FORMAT, ...) TR_LOG_NOTHING(FORMAT, ##__VA_ARGS__)
+#endif
+
+#if TR_LOG_LEVEL >= TR_LOG_LEVEL_TRACE
+#define TR_TRACE(FORMAT, ...) TR_LOG(LogLevel::TRACE, FORMAT, ##__VA_ARGS__)
+#else
+#define TR_TRACE(FORMAT, ...) TR_LOG_NOTHING(FORMAT, ##__VA_ARGS__)
+#endif
 
 TR_END_NAMESPACE()
 
@@ -0,0 +1,318 @@
+#include "imgui/imgui.h"
+
+#include <glad/glad.h> // OpenGL API
+
+#include <algorithm> // std::copy(), std::nth_element(), std::max_element()
+#include <cfloat> // FLT_MAX
+#include <cinttypes> // PRIu64
+#include <cstddef> // size_t
+#include <cstdint> // int64_t, uint32_t, uint64_t
+#include <cstdio> // fopen(), fprintf(), snprintf()
+#include <filesystem> // std::filesystem::path{}, std::filesystem::create_directories()
+#include <system_error> // std::error_code{}
+#include <thread> // std::this_thread::get_id()
+#include <vector> // std::vector{}
+
+#include "Profiler.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT, TR_ARRAYSIZE(), TR_MIN(), TR_MAX()
+#include "Log.hpp" // TR_INFO(), TR_ERROR()
+
+#define TR_PROFILER_BINS 32 // Frame time histogram
+
+TR_BEGIN_NAMESPACE()
+
+Profiler::Profiler(void) NOEXCEPT
+  : m_start(std::chrono::steady_clock::now()), m_thread(std::this_thread::get_id())
+{}
+
+Profiler::~Profiler(void) NOEXCEPT {
+  for (GpuFrame& gpuFrame: m_gpuFrames) {
+    if (!gpuFrame.queries.empty()) {
+      glDeleteQueries(static_cast<GLsizei>(gpuFrame.queries.size()), gpuFrame.queries.data());
+    }
+  }
+}
+
+// ╔═╗┬─┐┌─┐┌┬┐┌─┐
+// ╠╣ ├┬┘├─┤│││├┤
+// ╚  ┴└─┴ ┴┴ ┴└─┘
+
+void Profiler::BeginFrame(void) NOEXCEPT {
+  Resolve();
+
+  ProfilerFrame& frame = Current();
+  frame.index = m_frame;
+  frame.start = Now();
+  frame.end = frame.start;
+  frame.resolved = false;
+  frame.zones.clear(); // Keeps the capacity
+
+  // The slot still waits for the driver: drop it rather than stall.
+  GpuFrame& gpuFrame = m_gpuFrames[m_frame % TR_PROFILER_LATENCY];
+  if (gpuFrame.frame != UINT64_MAX) {
+    m_gpuDropped += 1u;
+  }
+  gpuFrame.frame = UINT64_MAX;
+  gpuFrame.used = 0u;
+  gpuFrame.zones.clear();
+
+  // Align the GPU clock on the CPU one (does not wait for the GPU).
+  if (m_gpu) {
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuFrame.cpuBase = Now();
+    gpuFrame.gpuBase = static_cast<int64_t>(gpuNow);
+  }
+
+  m_depth = m_gpuDepth = 0u;
+}
+
+void Profiler::EndFrame(void) NOEXCEPT {
+  ProfilerFrame& frame = Current();
+  frame.end = Now();
+
+  GpuFrame& gpuFrame = m_gpuFrames[m_frame % TR_PROFILER_LATENCY];
+  if (gpuFrame.zones.empty()) frame.resolved = true;
+  else gpuFrame.frame = m_frame;
+
+  if (!m_paused) m_frame += 1u;
+}
+
+uint32_t Profiler::Begin(char const* name) NOEXCEPT {
+  if (std::this_thread::get_id() != m_thread) return UINT32_MAX;
+  ProfilerFrame& frame = Current();
+  frame.zones.push_back({ name, m_depth++, false, Now(), 0 });
+  return static_cast<uint32_t>(frame.zones.size() - 1u);
+}
+
+void Profiler::End(uint32_t zone) NOEXCEPT {
+  if (zone == UINT32_MAX) return;
+  Current().zones[zone].end = Now();
+  m_depth -= 1u;
+}
+
+uint32_t Profiler::BeginGpu(char const* name) NOEXCEPT {
+  if (!m_gpu || std::this_thread::get_id() != m_thread) return UINT32_MAX;
+  ProfilerFrame& frame = Current();
+  GpuFrame& gpuFrame = m_gpuFrames[m_frame % TR_PROFILER_LATENCY];
+
+  // Grow the query pool of this slot, reused afterwards.
+  if (gpuFrame.used + 2u > gpuFrame.queries.size()) {
+    size_t size = gpuFrame.queries.size();
+    gpuFrame.queries.resize(size + 8u);
+    glGenQueries(8, gpuFrame.queries.data() + size);
+  }
+
+  frame.zones.push_back({ name, m_gpuDepth++, true, 0, 0 });
+  uint32_t zone = static_cast<uint32_t>(frame.zones.size() - 1u);
+  gpuFrame.zones.push_back(zone);
+
+  glQueryCounter(gpuFrame.queries[gpuFrame.used++], GL_TIMESTAMP);
+  return zone;
+}
+
+void Profiler::EndGpu(uint32_t zone) NOEXCEPT {
+  GpuFrame& gpuFrame = m_gpuFrames[m_frame % TR_PROFILER_LATENCY];
+  glQueryCounter(gpuFrame.queries[gpuFrame.used++], GL_TIMESTAMP);
+  m_gpuDepth -= 1u;
+  (void) zone; // Queries are consumed in order
+}
+
+void Profiler::Resolve(void) NOEXCEPT {
+  if (!m_gpu) return;
+  for (GpuFrame& gpuFrame: m_gpuFrames) {
+    if (gpuFrame.frame == UINT64_MAX) continue;
+
+    // The last query completes last.
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(gpuFrame.queries[gpuFrame.used - 1u], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) continue;
+
+    ProfilerFrame& frame = m_frames[gpuFrame.frame % TR_PROFILER_HISTORY];
+    if (frame.index == gpuFrame.frame) {
+      // Begin and end queries were issued in call order: replay the nesting,
+      // the next zone opens when its depth matches the open ones.
+      uint32_t stack[TR_PROFILER_DEPTH], depth = 0u;
+      size_t next = 0u; // Next zone to open
+
+      for (size_t query = 0u; query < gpuFrame.used; ++query) {
+        GLuint64 time = 0u;
+        glGetQueryObjectui64v(gpuFrame.queries[query], GL_QUERY_RESULT, &time);
+        int64_t cpuTime = static_cast<int64_t>(time) - gpuFrame.gpuBase + gpuFrame.cpuBase;
+
+        bool open = next < gpuFrame.zones.size()
+          && frame.zones[gpuFrame.zones[next]].depth == depth
+          && depth < TR_PROFILER_DEPTH;
+        if (open) {
+          frame.zones[gpuFrame.zones[next]].start = cpuTime;
+          stack[depth++] = gpuFrame.zones[next++];
+        }
+        else if (depth > 0u) {
+          frame.zones[stack[--depth]].end = cpuTime;
+        }
+      }
+      frame.resolved = true;
+    }
+
+    gpuFrame.frame = UINT64_MAX;
+  }
+}
+
+// ╔╦╗┬─┐┌─┐┌─┐┌─┐
+//  ║ ├┬┘├─┤│  ├┤
+//  ╩ ┴└─┴ ┴└─┘└─┘
+
+bool Profiler::ExportTrace(char const* path) const NOEXCEPT {
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+  FILE* file = fopen(path, "w");
+  if (file == NULL) {
+    TR_ERROR("Failed to open trace: %s", path);
+    return false;
+  }
+
+  // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n");
+  fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+
+  for (ProfilerFrame const& frame: m_frames) {
+    if (frame.index == UINT64_MAX || frame.end <= frame.start) continue;
+
+    fprintf(file, ",\n{\"name\":\"Frame %" PRIu64 "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+      frame.index, static_cast<double>(frame.start) / 1e3, static_cast<double>(frame.end - frame.start) / 1e3);
+
+    for (ProfilerZone const& zone: frame.zones) {
+      if (zone.gpu && !frame.resolved) continue;
+      fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+        zone.name, zone.gpu ? 2 : 1,
+        static_cast<double>(zone.start) / 1e3, static_cast<double>(TR_MAX(zone.end - zone.start, 0)) / 1e3);
+    }
+  }
+
+  fprintf(file, "\n]}\n");
+  fclose(file);
+  return true;
+}
+
+// ╦ ╦┬
+// ║ ║│
+// ╚═╝┴
+
+void Profiler::RenderTimeline(ProfilerFrame const& frame) NOEXCEPT {
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+  float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+  float width = ImGui::GetContentRegionAvail().x;
+
+  uint32_t cpuRows = 0u, gpuRows = 0u;
+  for (ProfilerZone const& zone: frame.zones) {
+    if (zone.gpu) gpuRows = TR_MAX(gpuRows, zone.depth + 1u);
+    else cpuRows = TR_MAX(cpuRows, zone.depth + 1u);
+  }
+
+  if (width <= 0.0f) return;
+
+  ImVec2 origin = ImGui::GetCursorScreenPos();
+  float height = rowHeight * static_cast<float>(cpuRows + gpuRows + 1u);
+  ImGui::InvisibleButton("##Timeline", ImVec2(width, height));
+
+  // GPU work lags behind: the scale covers both.
+  int64_t start = frame.start, end = frame.end;
+  for (ProfilerZone const& zone: frame.zones) {
+    if (zone.gpu && !frame.resolved) continue;
+    end = TR_MAX(end, zone.end);
+  }
+  float scale = width / static_cast<float>(TR_MAX(end - start, int64_t(1)));
+
+  ImU32 cpuColor = ImGui::GetColorU32(ImGuiCol_PlotHistogram);
+  ImU32 gpuColor = ImGui::GetColorU32(ImGuiCol_PlotLines);
+  ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+
+  for (ProfilerZone const& zone: frame.zones) {
+    if (zone.gpu && !frame.resolved) continue;
+
+    float row = static_cast<float>(zone.gpu ? cpuRows + 1u + zone.depth : zone.depth);
+    ImVec2 min(origin.x + static_cast<float>(zone.start - start) * scale, origin.y + row * rowHeight);
+    ImVec2 max(origin.x + static_cast<float>(zone.end - start) * scale, min.y + rowHeight - 1.0f);
+    max.x = TR_MAX(max.x, min.x + 1.0f);
+
+    drawList->AddRectFilled(min, max, zone.gpu ? gpuColor : cpuColor);
+    drawList->PushClipRect(min, max, true);
+    drawList->AddText(ImVec2(min.x + 2.0f, min.y), textColor, zone.name);
+    drawList->PopClipRect();
+
+    if (ImGui::IsMouseHoveringRect(min, max)) {
+      ImGui::SetTooltip("%s (%s) %.3f ms", zone.name, zone.gpu ? "GPU" : "CPU",
+        static_cast<double>(zone.end - zone.start) / 1e6);
+    }
+  }
+
+  if (gpuRows > 0u) {
+    float y = origin.y + static_cast<float>(cpuRows) * rowHeight;
+    drawList->AddText(ImVec2(origin.x, y), ImGui::GetColorU32(ImGuiCol_TextDisabled), "GPU");
+  }
+}
+
+void Profiler::RenderUi(void) NOEXCEPT {
+  // Frame times of the history, in milliseconds.
+  float durations[TR_PROFILER_HISTORY];
+  size_t count = 0u;
+  for (ProfilerFrame const& frame: m_frames) {
+    if (frame.index == UINT64_MAX || frame.end <= frame.start) continue;
+    durations[count++] = static_cast<float>(frame.end - frame.start) / 1e6f;
+  }
+  if (count == 0u) return;
+
+  float sorted[TR_PROFILER_HISTORY];
+  std::copy(durations, durations + count, sorted);
+  auto percentile = [&](float p) {
+    size_t index = TR_MIN(static_cast<size_t>(p * static_cast<float>(count)), count - 1u);
+    std::nth_element(sorted, sorted + index, sorted + count);
+    return sorted[index];
+  };
+  float p50 = percentile(0.50f), p95 = percentile(0.95f), p99 = percentile(0.99f);
+  float worst = *std::max_element(durations, durations + count);
+
+  ImGui::Text("p50 %.2f ms, p95 %.2f ms, p99 %.2f ms (max %.2f ms)", p50, p95, p99, worst);
+  if (m_gpuDropped > 0u) {
+    ImGui::SameLine(); ImGui::TextDisabled("(%zu GPU frames dropped)", m_gpuDropped);
+  }
+
+  // Distribution over [0, max].
+  float bins[TR_PROFILER_BINS] = {};
+  for (size_t i = 0u; i < count; ++i) {
+    int bin = static_cast<int>(durations[i] / worst * static_cast<float>(TR_PROFILER_BINS - 1));
+    bins[TR_MIN(TR_MAX(bin, 0), TR_PROFILER_BINS - 1)] += 1.0f;
+  }
+  char overlay[32];
+  snprintf(overlay, sizeof(overlay), "0 - %.1f ms", static_cast<double>(worst));
+  ImGui::PlotHistogram("##Histogram", bins, TR_PROFILER_BINS, 0, overlay, 0.0f, FLT_MAX, ImVec2(-1.0f, 48.0f));
+
+  ImGui::Checkbox("Pause", &m_paused);
+  ImGui::SameLine();
+  if (ImGui::Button("Export Trace")) {
+    char const* path = TR_BUILD_DIR "/traces/trace.json";
+    if (ExportTrace(path)) TR_INFO("Trace written to %s", path);
+  }
+
+  // Newest frame with its GPU zones known, or the selected one when paused.
+  uint64_t newest = m_frame == 0u ? 0u : m_frame - 1u;
+  if (m_paused) {
+    ImGui::SliderInt("Frames Back", &m_selected, 0, static_cast<int>(TR_MIN(count, size_t(TR_PROFILER_HISTORY)) - 1u));
+    newest -= TR_MIN(static_cast<uint64_t>(m_selected), newest);
+  }
+  else {
+    for (uint32_t back = 0u; back < TR_PROFILER_LATENCY && newest > 0u; ++back) {
+      if (m_frames[newest % TR_PROFILER_HISTORY].resolved) break;
+      newest -= 1u;
+    }
+  }
+
+  ProfilerFrame const& frame = m_frames[newest % TR_PROFILER_HISTORY];
+  if (frame.index != newest) return;
+  ImGui::SeparatorText("Timeline");
+  RenderTimeline(frame);
+}
+
+TR_END_NAMESPACE()
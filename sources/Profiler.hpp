@@ -0,0 +1,153 @@
+#ifndef TR_PROFILER_HPP
+#define TR_PROFILER_HPP
+
+#include <glad/glad.h> // GLuint
+
+#include <array> // std::array{}
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstddef> // size_t
+#include <cstdint> // int64_t, uint32_t, uint64_t
+#include <thread> // std::thread::id{}, std::this_thread::get_id()
+#include <vector> // std::vector{}
+
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_PROFILER_HISTORY 256u // Frames kept (histogram, timeline, trace)
+#define TR_PROFILER_LATENCY 4u // Frames of GPU queries in flight
+#define TR_PROFILER_DEPTH 16u // Nested GPU zones
+
+struct ProfilerZone {
+  char const* name; // String literal
+  uint32_t depth;
+  bool gpu;
+  int64_t start, end; // Nanoseconds since the profiler started
+};
+
+struct ProfilerFrame {
+  uint64_t index = UINT64_MAX;
+  int64_t start = 0, end = 0;
+  bool resolved = false; // GPU zones are known
+  std::vector<ProfilerZone> zones;
+};
+
+///
+/// Hierarchical CPU and GPU frame profiler (main thread only: zones opened
+/// on other threads are ignored).
+///
+/// GPU zones are bracketed by `GL_TIMESTAMP` queries (they nest, unlike
+/// `GL_TIME_ELAPSED`). Queries are read back `TR_PROFILER_LATENCY` frames
+/// later at most, and only when available: when the driver lags further
+/// behind the results are dropped, reading never stalls.
+///
+class Profiler final {
+public:
+  ///
+  /// RAII zone, `name` must outlive the profiler (string literal).
+  ///
+  /// ```cpp
+  /// { Profiler::Zone zone(profiler, "Render", true); Render(); }
+  /// ```
+  ///
+  class Zone final {
+  public:
+    inline Zone(Profiler& profiler, char const* name, bool gpu = false) NOEXCEPT
+      : m_profiler(profiler), m_cpu(profiler.Begin(name)), m_gpu(gpu ? profiler.BeginGpu(name) : UINT32_MAX) {}
+
+    inline ~Zone(void) NOEXCEPT {
+      if (m_gpu != UINT32_MAX) m_profiler.EndGpu(m_gpu);
+      m_profiler.End(m_cpu);
+    }
+
+  private:
+    TR_DELETE_COPY_CTOR(Zone);
+    TR_DELETE_MOVE_CTOR(Zone);
+
+    Profiler& m_profiler;
+    uint32_t m_cpu, m_gpu;
+  };
+
+public:
+  Profiler(void) NOEXCEPT;
+  ~Profiler(void) NOEXCEPT;
+
+  void BeginFrame(void) NOEXCEPT;
+  void EndFrame(void) NOEXCEPT;
+
+  uint32_t Begin(char const* name) NOEXCEPT;
+  void End(uint32_t zone) NOEXCEPT;
+  uint32_t BeginGpu(char const* name) NOEXCEPT;
+  void EndGpu(uint32_t zone) NOEXCEPT;
+
+  /// Read the queries of previous frames that are available (never waits,
+  /// also done by `BeginFrame()`).
+  void Resolve(void) NOEXCEPT;
+
+  ///
+  /// GPU zones need the context current on the main thread: disable them
+  /// before handing it over to another thread (CPU zones only, pending
+  /// queries are kept until enabled again).
+  ///
+  constexpr void SetGpu(bool enabled) NOEXCEPT {
+    m_gpu = enabled;
+  }
+
+  /// Frame `index` while it is in the history, NULL otherwise (its GPU zones
+  /// are only valid once `resolved`).
+  inline ProfilerFrame const* Frame(uint64_t index) const NOEXCEPT {
+    ProfilerFrame const& frame = m_frames[index % TR_PROFILER_HISTORY];
+    return frame.index == index ? &frame : NULL;
+  }
+
+  /// Index of the frame being recorded (or the next one).
+  constexpr uint64_t FrameIndex(void) const NOEXCEPT {
+    return m_frame;
+  }
+
+  /// Chrome `trace_event` JSON (chrome://tracing, Perfetto) of the history.
+  bool ExportTrace(char const* path) const NOEXCEPT;
+
+  void RenderUi(void) NOEXCEPT;
+
+private:
+  TR_DELETE_COPY_CTOR(Profiler);
+  TR_DELETE_MOVE_CTOR(Profiler);
+
+  inline int64_t Now(void) const NOEXCEPT {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - m_start
+    ).count();
+  }
+
+  constexpr ProfilerFrame& Current(void) NOEXCEPT {
+    return m_frames[m_frame % TR_PROFILER_HISTORY];
+  }
+
+  void RenderTimeline(ProfilerFrame const& frame) NOEXCEPT;
+
+  // Queries of one frame in call order (begin and end of nested `zones`).
+  struct GpuFrame {
+    uint64_t frame = UINT64_MAX; // Pending when not UINT64_MAX
+    int64_t cpuBase = 0, gpuBase = 0; // Clocks sampled at `BeginFrame()`
+    std::vector<GLuint> queries;
+    std::vector<uint32_t> zones;
+    size_t used = 0u;
+  };
+
+  std::chrono::steady_clock::time_point m_start;
+  std::thread::id m_thread; // Constructing (main) thread
+  std::array<ProfilerFrame, TR_PROFILER_HISTORY> m_frames;
+  std::array<GpuFrame, TR_PROFILER_LATENCY> m_gpuFrames;
+  uint64_t m_frame = 0u;
+  uint32_t m_depth = 0u, m_gpuDepth = 0u;
+  size_t m_gpuDropped = 0u;
+  bool m_gpu = true;
+
+  bool m_paused = false;
+  int m_selected = 0; // Frames back from the newest (paused only)
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_PROFILER_HPP
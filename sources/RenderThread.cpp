@@ -0,0 +1,158 @@
+#include "imgui/imgui.h"
+
+#include <glad/glad.h> // Before GLFW
+#include <GLFW/glfw3.h> // glfwMakeContextCurrent()
+
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstring> // memcpy()
+#include <mutex> // std::unique_lock{}, std::lock_guard{}
+#include <thread> // std::jthread{}, std::stop_token{}
+#include <utility> // std::move()
+
+#include "RenderThread.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT, TR_CLAMP()
+#include "Log.hpp" // TR_DEBUG()
+
+TR_BEGIN_NAMESPACE()
+
+// ╔═╗┌─┐┌─┐┬┌─┌─┐┌┬┐
+// ╠═╝├─┤│  ├┴┐├┤  │
+// ╩  ┴ ┴└─┘┴ ┴└─┘ ┴
+
+FramePacket::~FramePacket(void) NOEXCEPT {
+  for (ImDrawList* list: m_drawLists) {
+    IM_DELETE(list);
+  }
+}
+
+/// Resize (keeps the capacity) and copy.
+template <typename Type>
+static void CopyVector(ImVector<Type>& destination, ImVector<Type> const& source) NOEXCEPT {
+  destination.resize(source.Size);
+  if (source.Size > 0) memcpy(destination.Data, source.Data, source.size_in_bytes());
+}
+
+ImDrawData* FramePacket::CopyDrawData(ImDrawData const& source) NOEXCEPT {
+  while (m_drawLists.Size < source.CmdListsCount) {
+    m_drawLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+  }
+
+  m_drawData.Clear(); // Keeps the capacity
+  m_drawData.Valid = source.Valid;
+  m_drawData.CmdListsCount = source.CmdListsCount;
+  m_drawData.TotalIdxCount = source.TotalIdxCount;
+  m_drawData.TotalVtxCount = source.TotalVtxCount;
+  m_drawData.DisplayPos = source.DisplayPos;
+  m_drawData.DisplaySize = source.DisplaySize;
+  m_drawData.FramebufferScale = source.FramebufferScale;
+  m_drawData.OwnerViewport = source.OwnerViewport;
+
+  for (int i = 0; i < source.CmdListsCount; ++i) {
+    ImDrawList const* list = source.CmdLists[i];
+    ImDrawList* copy = m_drawLists[i];
+    CopyVector(copy->CmdBuffer, list->CmdBuffer);
+    CopyVector(copy->IdxBuffer, list->IdxBuffer);
+    CopyVector(copy->VtxBuffer, list->VtxBuffer);
+    copy->Flags = list->Flags;
+    m_drawData.CmdLists.push_back(copy);
+  }
+
+  return &m_drawData;
+}
+
+// ╔╦╗┬ ┬┬─┐┌─┐┌─┐┌┬┐
+//  ║ ├─┤├┬┘├┤ ├─┤ ││
+//  ╩ ┴ ┴┴└─└─┘┴ ┴─┴┘
+
+RenderThread::RenderThread(Execute execute) NOEXCEPT
+  : m_execute(std::move(execute))
+{}
+
+RenderThread::~RenderThread(void) NOEXCEPT {
+  Stop();
+}
+
+void RenderThread::Start(GLFWwindow* window) NOEXCEPT {
+  if (Running()) return;
+
+  // A context is current on one thread at a time.
+  m_window = window;
+  glfwMakeContextCurrent(NULL);
+  m_thread = std::jthread([this] (std::stop_token stop) { Render(stop); });
+  TR_DEBUG("Render thread started (%u frames in flight).", m_framesInFlight);
+}
+
+void RenderThread::Stop(void) NOEXCEPT {
+  if (!Running()) return;
+
+  m_thread.request_stop(); // Wakes it up, the queued packets are executed.
+  m_thread.join();
+  glfwMakeContextCurrent(m_window);
+  TR_DEBUG("Render thread stopped.");
+}
+
+FramePacket& RenderThread::Acquire(void) NOEXCEPT {
+  std::unique_lock lock(m_mutex);
+  m_condition.wait(lock, [this] { return m_submitted - m_executed < m_framesInFlight; });
+  return m_packets[m_submitted % TR_FRAMES_IN_FLIGHT];
+}
+
+void RenderThread::Submit(void) NOEXCEPT {
+  if (!Running()) {
+    Run(m_packets[m_submitted % TR_FRAMES_IN_FLIGHT]);
+    m_submitted += 1u; m_executed += 1u;
+    return;
+  }
+
+  {
+    std::lock_guard lock(m_mutex);
+    m_submitted += 1u;
+  }
+  m_condition.notify_all();
+}
+
+void RenderThread::SetFramesInFlight(uint32_t frames) NOEXCEPT {
+  {
+    std::lock_guard lock(m_mutex);
+    m_framesInFlight = TR_CLAMP(frames, 1u, TR_FRAMES_IN_FLIGHT);
+  }
+  m_condition.notify_all();
+}
+
+void RenderThread::Run(FramePacket const& packet) NOEXCEPT {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  m_execute(packet);
+
+  std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+  double average = m_milliseconds.load(std::memory_order_relaxed);
+  m_milliseconds.store(average + (elapsed.count() - average) * 0.05, std::memory_order_relaxed);
+}
+
+void RenderThread::Render(std::stop_token stop) NOEXCEPT {
+  glfwMakeContextCurrent(m_window);
+
+  for (;;) {
+    FramePacket const* packet;
+    {
+      std::unique_lock lock(m_mutex);
+      // Still true after a stop request while packets are queued.
+      if (!m_condition.wait(lock, stop, [this] { return m_executed != m_submitted; })) {
+        break;
+      }
+      packet = &m_packets[m_executed % TR_FRAMES_IN_FLIGHT];
+    }
+
+    Run(*packet);
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_executed += 1u;
+    }
+    m_condition.notify_all(); // A packet is free
+  }
+
+  glfwMakeContextCurrent(NULL);
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,125 @@
+#ifndef TR_RENDER_THREAD_HPP
+#define TR_RENDER_THREAD_HPP
+
+#include <glad/glad.h> // Before GLFW
+#include <GLFW/glfw3.h> // GLFWwindow{}
+#include "imgui/imgui.h" // ImDrawData{}, ImDrawList{}
+
+#include <array> // std::array{}
+#include <atomic> // std::atomic{}
+#include <condition_variable> // std::condition_variable_any{}
+#include <cstdint> // uint32_t, uint64_t
+#include <functional> // std::move_only_function{}
+#include <mutex> // std::mutex{}
+#include <thread> // std::jthread{}
+
+#include "Engine.hpp" // EngineFrame{}
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+#define TR_FRAMES_IN_FLIGHT 3u // Packets, the most frames in flight
+
+///
+/// Immutable once submitted: everything the render thread needs to draw and
+/// present one frame, without touching the state of the main thread.
+///
+struct FramePacket {
+  FramePacket(void) NOEXCEPT = default;
+  ~FramePacket(void) NOEXCEPT;
+
+  ///
+  /// Deep copy of the ImGui draw lists (reusing the buffers of the previous
+  /// use of this packet): the main thread starts the next ImGui frame while
+  /// this one is drawn. Returns `&m_drawData`.
+  ///
+  ImDrawData* CopyDrawData(ImDrawData const& source) NOEXCEPT;
+
+  EngineFrame engine;
+  GLint viewport[4] = {}; // x, y, width, height
+  ImVec4 clearColor{};
+  bool wireframe = false;
+  int swapInterval = 1;
+  ImDrawData* drawData = NULL; // ImGui's own, or the copy
+
+private:
+  TR_DELETE_COPY_CTOR(FramePacket);
+  TR_DELETE_MOVE_CTOR(FramePacket);
+
+  ImDrawData m_drawData;
+  ImVector<ImDrawList*> m_drawLists; // Owned
+};
+
+///
+/// Decouple frame preparation (input, simulation, culling, UI) from the
+/// OpenGL submission with a ring of `TR_FRAMES_IN_FLIGHT` packets.
+///
+/// The main thread fills the packet returned by `Acquire()` and queues it
+/// with `Submit()`. Once `Start()`ed, the render thread owns the context and
+/// executes the packets in order, so the main thread prepares frame N + 1
+/// while frame N is drawn. `Acquire()` blocks while `FramesInFlight()`
+/// packets are queued or drawn: more frames in flight absorb spikes on
+/// either side at the cost of latency.
+///
+/// When not started, `Submit()` executes the packet right away on the
+/// calling thread (single-threaded mode).
+///
+class RenderThread final {
+public:
+  /// Draw and present a packet, on the thread owning the context.
+  using Execute = std::move_only_function<void(FramePacket const&)>;
+
+  explicit RenderThread(Execute execute) NOEXCEPT;
+  ~RenderThread(void) NOEXCEPT; // `Stop()`
+
+  /// Hand the context of `window` (current on the caller) over to a new
+  /// render thread.
+  void Start(GLFWwindow* window) NOEXCEPT;
+
+  /// Execute the queued packets, join the render thread and make the
+  /// context current on the caller again.
+  void Stop(void) NOEXCEPT;
+
+  FramePacket& Acquire(void) NOEXCEPT;
+  void Submit(void) NOEXCEPT;
+
+  /// Clamped to [1, TR_FRAMES_IN_FLIGHT].
+  void SetFramesInFlight(uint32_t frames) NOEXCEPT;
+
+  inline bool Running(void) const NOEXCEPT {
+    return m_thread.joinable();
+  }
+
+  constexpr uint32_t FramesInFlight(void) const NOEXCEPT {
+    return m_framesInFlight;
+  }
+
+  /// Time spent executing a packet (moving average), in milliseconds.
+  inline double Milliseconds(void) const NOEXCEPT {
+    return m_milliseconds.load(std::memory_order_relaxed);
+  }
+
+private:
+  TR_DELETE_COPY_CTOR(RenderThread);
+  TR_DELETE_MOVE_CTOR(RenderThread);
+
+  void Run(FramePacket const& packet) NOEXCEPT; // Timed `m_execute`
+  void Render(std::stop_token stop) NOEXCEPT; // Thread
+
+  Execute m_execute;
+  GLFWwindow* m_window = NULL;
+  std::array<FramePacket, TR_FRAMES_IN_FLIGHT> m_packets;
+
+  std::mutex m_mutex;
+  std::condition_variable_any m_condition;
+  uint64_t m_submitted = 0u, m_executed = 0u; // Monotonic packet counters
+  uint32_t m_framesInFlight = 2u;
+  std::atomic<double> m_milliseconds = 0.0;
+
+  // Last member: joined before the packets are destroyed.
+  std::jthread m_thread;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_RENDER_THREAD_HPP
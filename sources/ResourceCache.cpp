@@ -0,0 +1,182 @@
+#include "imgui/imgui.h"
+
+#include <algorithm> // std::find(), std::sort()
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstdio> // snprintf()
+#include <memory> // std::make_shared()
+#include <mutex> // std::lock_guard{}
+#include <optional> // std::optional{}
+#include <span> // std::span{}
+#include <string> // std::string{}
+#include <string_view> // std::string_view{}
+#include <utility> // std::move()
+#include <vector> // std::vector{}
+
+#include "Hash.hpp" // Hash()
+#include "ResourceCache.hpp" // Self{}
+#include "Shader.hpp" // Shader{}, ShaderSource{}, ShaderDefine{}
+#include "Texture.hpp" // Texture{}
+#include "helper.hpp" // NOEXCEPT
+#include "Log.hpp" // TR_DEBUG()
+
+TR_BEGIN_NAMESPACE()
+
+template <typename Resource>
+std::shared_ptr<Resource> ResourceCache::Find(std::vector<Entry<Resource>>& entries, uint64_t key, uint64_t frame) NOEXCEPT {
+  for (Entry<Resource>& entry: entries) {
+    if (entry.key == key) {
+      entry.lastUse = frame;
+      return entry.resource;
+    }
+  }
+  return NULL;
+}
+
+std::shared_ptr<Texture> ResourceCache::GetTexture(std::string_view filename) NOEXCEPT {
+  std::lock_guard lock(m_mutex);
+  uint64_t key = Hash(filename);
+  if (std::shared_ptr<Texture> texture = Find(m_textures, key, m_frame)) {
+    return texture;
+  }
+
+  std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+  m_loader.Load(texture, filename);
+  m_textures.push_back({ key, std::string(filename), texture, m_frame, 0u });
+  return texture;
+}
+
+std::shared_ptr<Shader> ResourceCache::GetShader(std::string_view name, std::initializer_list<ShaderSource> sources) NOEXCEPT {
+  return GetShader(std::string(name), std::span(sources.begin(), sources.size()), {});
+}
+
+std::shared_ptr<Shader> ResourceCache::GetShader(
+  std::initializer_list<std::string_view> filenames, std::span<ShaderDefine const> defines
+) NOEXCEPT {
+  std::string name;
+  std::vector<ShaderSource> sources;
+  sources.reserve(filenames.size());
+
+  for (std::string_view filename: filenames) {
+    if (std::optional<ShaderSource> source = Shader::Read(filename)) {
+      sources.push_back(std::move(*source));
+    }
+    if (!name.empty()) name += ", ";
+    name += filename;
+  }
+
+  return GetShader(std::move(name), sources, defines);
+}
+
+std::shared_ptr<Shader> ResourceCache::GetShader(
+  std::string name, std::span<ShaderSource const> sources, std::span<ShaderDefine const> defines
+) NOEXCEPT {
+  uint64_t key = Shader::Key(sources);
+  for (ShaderDefine const& define: defines) {
+    key = Hash(define.value, Hash(define.name, key));
+  }
+
+  std::lock_guard lock(m_mutex);
+  if (std::shared_ptr<Shader> shader = Find(m_shaders, key, m_frame)) {
+    return shader;
+  }
+
+  std::shared_ptr<Shader> shader = std::make_shared<Shader>();
+  for (ShaderDefine const& define: defines) {
+    shader->Define(define.name, define.value);
+  }
+  for (ShaderSource const& source: sources) {
+    shader->Attach(source.type, source.source);
+  }
+  shader->Link();
+
+  if (!defines.empty()) {
+    char variant[16];
+    snprintf(variant, sizeof(variant), " [%08x]", static_cast<unsigned>(key));
+    name += variant;
+  }
+
+  m_shaders.push_back({ key, std::move(name), shader, m_frame, 0u });
+  return shader;
+}
+
+void ResourceCache::Collect(void) NOEXCEPT {
+  std::lock_guard lock(m_mutex);
+  m_frame += 1u;
+  m_bytes = 0u;
+
+  struct Candidate {
+    uint64_t lastUse;
+    size_t bytes;
+    std::string const* name;
+    void const* resource; // Identity only
+  };
+  std::vector<Candidate> candidates;
+
+  auto visit = [&] <typename Resource> (std::vector<Entry<Resource>>& entries) {
+    for (Entry<Resource>& entry: entries) {
+      size_t bytes = entry.bytes = entry.resource->Bytes();
+      m_bytes += bytes;
+      if (entry.resource.use_count() > 1) {
+        entry.lastUse = m_frame; // Still referenced (or loading).
+      }
+      else {
+        candidates.push_back({ entry.lastUse, bytes, &entry.name, entry.resource.get() });
+      }
+    }
+  };
+  visit(m_textures);
+  visit(m_shaders);
+
+  if (m_bytes <= m_budget) return;
+
+  // Least recently used first.
+  std::sort(candidates.begin(), candidates.end(), [](Candidate const& a, Candidate const& b) {
+    return a.lastUse < b.lastUse;
+  });
+
+  std::vector<void const*> evicted;
+  for (Candidate const& candidate: candidates) {
+    if (m_bytes <= m_budget) break;
+    TR_DEBUG("Evict %s (%zu bytes)", candidate.name->c_str(), candidate.bytes);
+    evicted.push_back(candidate.resource);
+    m_bytes -= candidate.bytes;
+  }
+
+  auto isEvicted = [&](auto const& entry) {
+    return std::find(evicted.begin(), evicted.end(), entry.resource.get()) != evicted.end();
+  };
+  std::erase_if(m_textures, isEvicted);
+  std::erase_if(m_shaders, isEvicted);
+}
+
+void ResourceCache::RenderUi(void) NOEXCEPT {
+  std::lock_guard lock(m_mutex);
+  int budget = static_cast<int>(m_budget >> 20);
+  if (ImGui::DragInt("Budget", &budget, 1.0f, 1, 4096, "%d MiB")) {
+    m_budget = static_cast<size_t>(budget) << 20;
+  }
+  ImGui::Text("%.2f MiB used", static_cast<double>(m_bytes) / (1u << 20));
+
+  ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+  if (ImGui::BeginTable("Resources", 3, flags)) {
+    ImGui::TableSetupColumn("Name");
+    ImGui::TableSetupColumn("KiB");
+    ImGui::TableSetupColumn("Refs");
+    ImGui::TableHeadersRow();
+
+    auto rows = [] <typename Resource> (std::vector<Entry<Resource>> const& entries) {
+      for (Entry<Resource> const& entry: entries) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::TextUnformatted(entry.name.c_str());
+        ImGui::TableNextColumn(); ImGui::Text("%.1f", static_cast<double>(entry.bytes) / 1024.0);
+        ImGui::TableNextColumn(); ImGui::Text("%ld", entry.resource.use_count() - 1); // Minus the cache
+      }
+    };
+    rows(m_textures);
+    rows(m_shaders);
+    ImGui::EndTable();
+  }
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,90 @@
+#ifndef TR_RESOURCE_CACHE_HPP
+#define TR_RESOURCE_CACHE_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <initializer_list> // std::initializer_list{}
+#include <memory> // std::shared_ptr{}
+#include <mutex> // std::mutex{}, std::lock_guard{}
+#include <span> // std::span{}
+#include <string> // std::string{}
+#include <string_view> // std::string_view{}
+#include <vector> // std::vector{}
+
+#include "Shader.hpp" // Shader{}, ShaderSource{}, ShaderDefine{}
+#include "Texture.hpp" // Texture{}
+#include "TextureLoader.hpp" // TextureLoader{}
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Load each texture (by path) and each shader program (by source hash) once.
+///
+/// Handles are reference counted, a resource only referenced by the cache is
+/// unused: `Collect()` evicts the least recently used ones while the total
+/// exceeds the memory budget.
+///
+/// Resources are created and released on the GL thread, `RenderUi()` may be
+/// called from another one (see `RenderThread{}`).
+///
+class ResourceCache final {
+public:
+  explicit ResourceCache(TextureLoader& loader) NOEXCEPT
+    : m_loader(loader) {}
+
+  /// Asynchronously loaded from "resources/textures/".
+  std::shared_ptr<Texture> GetTexture(std::string_view filename) NOEXCEPT;
+
+  /// Compiled and linked from in-memory stages.
+  std::shared_ptr<Shader> GetShader(std::string_view name, std::initializer_list<ShaderSource> sources) NOEXCEPT;
+
+  /// Read from "resources/shaders/", one program per set of `defines`.
+  std::shared_ptr<Shader> GetShader(
+    std::initializer_list<std::string_view> filenames,
+    std::span<ShaderDefine const> defines = {}
+  ) NOEXCEPT;
+
+  /// Evict unused resources over budget, called once per frame.
+  void Collect(void) NOEXCEPT;
+
+  void RenderUi(void) NOEXCEPT;
+
+  inline size_t Bytes(void) const NOEXCEPT { std::lock_guard lock(m_mutex); return m_bytes; }
+  inline size_t Budget(void) const NOEXCEPT { std::lock_guard lock(m_mutex); return m_budget; }
+  inline void SetBudget(size_t bytes) NOEXCEPT { std::lock_guard lock(m_mutex); m_budget = bytes; }
+
+private:
+  TR_DELETE_COPY_CTOR(ResourceCache);
+  TR_DELETE_MOVE_CTOR(ResourceCache);
+
+  template <typename Resource>
+  struct Entry {
+    uint64_t key;
+    std::string name;
+    std::shared_ptr<Resource> resource;
+    uint64_t lastUse; // Last frame it was referenced outside the cache
+    size_t bytes = 0u; // As of the last `Collect()`
+  };
+
+  std::shared_ptr<Shader> GetShader(
+    std::string name, std::span<ShaderSource const> sources, std::span<ShaderDefine const> defines
+  ) NOEXCEPT;
+
+  template <typename Resource>
+  static std::shared_ptr<Resource> Find(std::vector<Entry<Resource>>& entries, uint64_t key, uint64_t frame) NOEXCEPT;
+
+  TextureLoader& m_loader;
+
+  mutable std::mutex m_mutex; // Guards the members below
+  std::vector<Entry<Texture>> m_textures;
+  std::vector<Entry<Shader>> m_shaders;
+
+  size_t m_budget = 256u << 20; // 256 MiB
+  size_t m_bytes = 0u; // Updated by `Collect()`
+  uint64_t m_frame = 0u;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_RESOURCE_CACHE_HPP
@@ -0,0 +1,86 @@
+#include <cassert> // assert()
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+#include "Scene.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT, TR_ASSERT()
+
+TR_BEGIN_NAMESPACE()
+
+Entity Scene::Add(Description const& description) NOEXCEPT {
+  uint32_t slot;
+  if (m_freeSlot != UINT32_MAX) {
+    slot = m_freeSlot;
+    m_freeSlot = m_slots[slot].index;
+  }
+  else {
+    slot = static_cast<uint32_t>(m_slots.size());
+    m_slots.push_back({ 0u, 0u });
+  }
+
+  m_slots[slot].index = static_cast<uint32_t>(m_entities.size());
+  Entity entity = { slot, m_slots[slot].generation };
+
+  m_entities.push_back(entity);
+  m_transforms.Push(description.position, description.axis, description.angle, description.scale);
+  m_spins.push_back(description.spin);
+  m_meshes.push_back(description.mesh);
+  m_materials.push_back(description.material);
+  m_radii.push_back(description.radius * description.scale);
+  m_flags.push_back(description.flags);
+  return entity;
+}
+
+bool Scene::Remove(Entity entity) NOEXCEPT {
+  if (!Alive(entity)) return false;
+
+  size_t index = m_slots[entity.slot].index;
+  Entity last = m_entities.back();
+
+  // Swap-remove every component, then patch the moved entity's slot.
+  m_entities[index] = last; m_entities.pop_back();
+  m_transforms.SwapRemove(index);
+  m_spins[index] = m_spins.back(); m_spins.pop_back();
+  m_meshes[index] = m_meshes.back(); m_meshes.pop_back();
+  m_materials[index] = m_materials.back(); m_materials.pop_back();
+  m_radii[index] = m_radii.back(); m_radii.pop_back();
+  m_flags[index] = m_flags.back(); m_flags.pop_back();
+  m_slots[last.slot].index = static_cast<uint32_t>(index);
+
+  // Invalidate the handle and push the slot onto the free list.
+  m_slots[entity.slot].generation += 1u;
+  m_slots[entity.slot].index = m_freeSlot;
+  m_freeSlot = entity.slot;
+  return true;
+}
+
+void Scene::Clear(void) NOEXCEPT {
+  while (!m_entities.empty()) {
+    Remove(m_entities.back());
+  }
+}
+
+void Scene::Reserve(size_t capacity) NOEXCEPT {
+  m_slots.reserve(capacity);
+  m_entities.reserve(capacity);
+  m_transforms.Reserve(capacity);
+  m_spins.reserve(capacity);
+  m_meshes.reserve(capacity);
+  m_materials.reserve(capacity);
+  m_radii.reserve(capacity);
+  m_flags.reserve(capacity);
+}
+
+bool Scene::Alive(Entity entity) const NOEXCEPT {
+  return entity.slot < m_slots.size()
+    && m_slots[entity.slot].generation == entity.generation
+    && m_slots[entity.slot].index < m_entities.size()
+    && m_entities[m_slots[entity.slot].index] == entity;
+}
+
+size_t Scene::Index(Entity entity) const NOEXCEPT {
+  TR_ASSERT(Alive(entity));
+  return m_slots[entity.slot].index;
+}
+
+TR_END_NAMESPACE()
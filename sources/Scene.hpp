@@ -0,0 +1,121 @@
+#ifndef TR_SCENE_HPP
+#define TR_SCENE_HPP
+
+#include <glm/vec3.hpp> // glm::vec3{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <span> // std::span{}
+#include <vector> // std::vector{}
+
+#include "Transform.hpp" // TransformArrays{}
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Stable handle to an entity of a `Scene`.
+///
+/// The generation invalidates handles of removed entities, even when their
+/// slot is reused.
+///
+struct Entity {
+  uint32_t slot = UINT32_MAX;
+  uint32_t generation = 0u;
+
+  constexpr bool operator==(Entity const&) const NOEXCEPT = default;
+};
+
+///
+/// Data-oriented entity store.
+///
+/// Components are stored in dense parallel arrays (indexed by the same dense
+/// index), so systems walk them linearly. Removal is O(1): the last entity is
+/// swapped into the hole, dense indices are therefore *not* stable, handles
+/// are.
+///
+class Scene final {
+public:
+  enum Mesh: uint32_t {
+    MESH_CUBE = 0u,
+  };
+
+  enum Material: uint32_t {
+    MATERIAL_CONTAINER = 0u,
+  };
+
+  enum Flags: uint32_t {
+    FLAG_NONE     = 0x0u,
+    FLAG_VISIBLE  = 0x1u, // Submitted for rendering
+    FLAG_ANIMATED = 0x2u, // Spins around its rotation axis
+  };
+
+  struct Description {
+    glm::vec3 position = { 0.0f, 0.0f, 0.0f };
+    glm::vec3 axis = { 0.0f, 1.0f, 0.0f };
+    float angle = 0.0f; // Radians
+    float scale = 1.0f;
+    float spin = 0.0f; // Radians per second
+    Mesh mesh = MESH_CUBE;
+    Material material = MATERIAL_CONTAINER;
+    float radius = 0.8660254f; // Bounding sphere, sqrt(3) / 2 for a unit cube
+    uint32_t flags = FLAG_VISIBLE;
+  };
+
+public:
+  Entity Add(Description const& description) NOEXCEPT;
+  bool Remove(Entity entity) NOEXCEPT;
+  void Clear(void) NOEXCEPT;
+  void Reserve(size_t capacity) NOEXCEPT;
+
+  bool Alive(Entity entity) const NOEXCEPT;
+
+  /// Dense index of a living entity (only valid until the next removal).
+  size_t Index(Entity entity) const NOEXCEPT;
+
+  constexpr size_t Size(void) const NOEXCEPT {
+    return m_entities.size();
+  }
+
+  /// Handle of the entity stored at a dense index.
+  constexpr Entity At(size_t index) const NOEXCEPT {
+    return m_entities[index];
+  }
+
+public:
+  // Dense component arrays, all of length `Size()`.
+
+  constexpr TransformArrays& Transforms(void) NOEXCEPT { return m_transforms; }
+  constexpr TransformArrays const& Transforms(void) const NOEXCEPT { return m_transforms; }
+
+  constexpr std::span<float> Spins(void) NOEXCEPT { return m_spins; }
+  constexpr std::span<Mesh const> Meshes(void) const NOEXCEPT { return m_meshes; }
+  constexpr std::span<Material const> Materials(void) const NOEXCEPT { return m_materials; }
+  constexpr std::span<float> Radii(void) NOEXCEPT { return m_radii; }
+  constexpr std::span<float const> Radii(void) const NOEXCEPT { return m_radii; }
+  constexpr std::span<uint32_t> EntityFlags(void) NOEXCEPT { return m_flags; }
+  constexpr std::span<uint32_t const> EntityFlags(void) const NOEXCEPT { return m_flags; }
+
+private:
+  struct Slot {
+    uint32_t index; // Dense index, or next free slot when unused
+    uint32_t generation;
+  };
+
+  // Sparse: handle slot -> dense index.
+  std::vector<Slot> m_slots;
+  uint32_t m_freeSlot = UINT32_MAX;
+
+  // Dense: dense index -> handle, then one array per component.
+  std::vector<Entity> m_entities;
+  TransformArrays m_transforms;
+  std::vector<float> m_spins;
+  std::vector<Mesh> m_meshes;
+  std::vector<Material> m_materials;
+  std::vector<float> m_radii;
+  std::vector<uint32_t> m_flags;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_SCENE_HPP
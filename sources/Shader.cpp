@@ -1,14 +1,29 @@
 #include <glad/glad.h> // OpenGL API
 
-#include <fstream> // std::ifstream{}
+#include <algorithm> // std::find(), std::lower_bound(), std::sort()
+#include <cinttypes> // PRIx64
+#include <cstdio> // snprintf()
+#include <cstring> // memcmp(), memcpy()
+#include <filesystem> // std::filesystem::path{}
+#include <fstream> // std::ifstream{}, std::ofstream{}
+#include <iterator> // std::istreambuf_iterator{}
 #include <memory> // std::unique_ptr{}
+#include <optional> // std::optional{}
 #include <sstream> // std::stringstream{}
-#include <string> // std::string{}
+#include <string> // std::string{}, std::to_string()
+#include <vector> // std::vector{}
 
-#include "helper.hpp" // NOEXCEPT
+#include "FrameConstants.hpp" // TR_FRAME_BLOCK, TR_FRAME_BINDING
+#include "Hash.hpp" // Hash()
+#include "helper.hpp" // NOEXCEPT, TR_MIN()
 #include "Shader.hpp" // Self{}
 #include "Log.hpp" // TR_ERROR()
 
+#define TR_SHADER_BINARY_MAGIC "TRPB"
+
+// KHR_parallel_shader_compile (same value for the ARB variant).
+#define TR_GL_COMPLETION_STATUS_KHR 0x91B1
+
 TR_BEGIN_NAMESPACE()
 
 static char const* ShaderType(GLenum type) NOEXCEPT {
@@ -26,29 +41,31 @@ static char const* ShaderType(GLenum type) NOEXCEPT {
   }
 }
 
-void Shader::Attach(GLenum type, std::string_view source) NOEXCEPT {
-  GLint status, length;
-  GLuint shader = glCreateShader(type);
-  char const* data = source.data();
-  glShaderSource(shader, 1, &data, NULL);
-  glCompileShader(shader);
-
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
-  if (status == GL_FALSE) {
-    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
-    std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
-    glGetShaderInfoLog(shader, length, NULL, buffer.get());
-    TR_ERROR("Shader::Compile(%s) Error:\n%*.*s",
-      ShaderType(type), length, length, buffer.get()
-    );
+uint64_t Shader::Key(std::span<ShaderSource const> sources) NOEXCEPT {
+  // The stage is part of the key: the same text may be compiled as two stages.
+  uint64_t key = TR_HASH_SEED;
+  for (ShaderSource const& source: sources) {
+    key = Hash(source.source, key ^ source.type);
   }
+  return key;
+}
+
+void Shader::Attach(GLenum type, std::string_view source) NOEXCEPT {
+  m_sources.push_back({ type, Preprocess(source, m_defines) });
+  m_bytes += m_sources.back().source.size();
+}
 
-  // https://gamedev.stackexchange.com/questions/47910/after-a-succesful-gllinkprogram-should-i-delete-detach-my-shaders
-  glAttachShader(m_program, shader);
-  glDeleteShader(shader);
+void Shader::Define(std::string_view name, std::string_view value) NOEXCEPT {
+  m_defines.push_back({ std::string(name), std::string(value) });
 }
 
 void Shader::Attach(std::string_view filename) NOEXCEPT {
+  if (std::optional<ShaderSource> source = Read(filename)) {
+    Attach(source->type, source->source);
+  }
+}
+
+std::optional<ShaderSource> Shader::Read(std::string_view filename) NOEXCEPT {
   GLenum type = 0;
   std::string_view search = filename;
 
@@ -56,7 +73,7 @@ void Shader::Attach(std::string_view filename) NOEXCEPT {
     size_t index = search.rfind(".");
     if (index == std::string_view::npos) {
       TR_ERROR("Shader extension is missing: %s", filename.data());
-      return;
+      return std::nullopt;
     }
 
     std::string_view extension = search.substr(index + 1);
@@ -67,29 +84,353 @@ void Shader::Attach(std::string_view filename) NOEXCEPT {
     else if (extension == "glsl") search = search.substr(0, index);
     else {
       TR_ERROR("Unknown shader extension: %s", filename.data());
-      return;
+      return std::nullopt;
     }
   } while(type == 0);
 
   std::string path = TR_RESOURCES_DIR "/shaders/";
   std::ifstream file(path += filename);
+  if (!file) {
+    TR_ERROR("Failed to open shader: %s", path.c_str());
+    return std::nullopt;
+  }
+
   std::stringstream buffer;
   buffer << file.rdbuf();
-  std::string source = buffer.str();
-  Attach(type, source);
+  return ShaderSource{ type, buffer.str() };
 }
 
-void Shader::Link(void) NOEXCEPT {
-  GLint length;
+// ╔═╗┬─┐┌─┐┌─┐┬─┐┌─┐┌─┐┌─┐┌─┐┌─┐┌─┐┬─┐
+// ╠═╝├┬┘├┤ ├─┘├┬┘│ ││  ├┤ └─┐└─┐│ │├┬┘
+// ╩  ┴└─└─┘┴  ┴└─└─┘└─┘└─┘└─┘└─┘└─┘┴└─
+
+#define TR_SHADER_INCLUDE_DEPTH 16
+
+static void Expand(
+  std::string& output, std::string_view source, std::span<ShaderDefine const> defines,
+  std::vector<std::string>& included, int depth
+) NOEXCEPT {
+  for (size_t line = 1u; !source.empty(); ++line) {
+    size_t end = source.find('\n');
+    std::string_view text = source.substr(0, end);
+    source = end == std::string_view::npos ? std::string_view() : source.substr(end + 1);
+
+    std::string_view directive = text.substr(TR_MIN(text.find_first_not_of(" \t"), text.size()));
+
+    if (directive.starts_with("#version")) {
+      output += text; output += '\n';
+      for (ShaderDefine const& define: defines) {
+        output += "#define "; output += define.name;
+        output += ' '; output += define.value; output += '\n';
+      }
+      if (!defines.empty()) output += "#line " + std::to_string(line + 1u) + "\n";
+      continue;
+    }
+
+    if (!directive.starts_with("#include")) {
+      output += text; output += '\n';
+      continue;
+    }
+
+    size_t first = directive.find('"'), last = directive.rfind('"');
+    if (first == std::string_view::npos || first == last || depth >= TR_SHADER_INCLUDE_DEPTH) {
+      TR_ERROR("Invalid shader include: %.*s", static_cast<int>(directive.size()), directive.data());
+      output += '\n';
+      continue;
+    }
+
+    std::string filename(directive.substr(first + 1, last - first - 1));
+    if (std::find(included.begin(), included.end(), filename) != included.end()) {
+      output += '\n'; // Already included.
+      continue;
+    }
+    included.push_back(filename);
+
+    std::string path = TR_RESOURCES_DIR "/shaders/"; path += filename;
+    std::ifstream file(path);
+    if (!file) {
+      TR_ERROR("Failed to open shader include: %s", path.c_str());
+      output += '\n';
+      continue;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    output += "#line 1\n";
+    Expand(output, buffer.str(), {}, included, depth + 1);
+    output += "#line " + std::to_string(line + 1u) + "\n";
+  }
+}
+
+std::string Shader::Preprocess(std::string_view source, std::span<ShaderDefine const> defines) NOEXCEPT {
+  std::string output;
+  std::vector<std::string> included;
+  output.reserve(source.size());
+  Expand(output, source, defines, included, 0);
+  return output;
+}
+
+// ╔╗ ┬┌┐┌┌─┐┬─┐┬ ┬  ╔═╗┌─┐┌─┐┬ ┬┌─┐
+// ╠╩╗││││├─┤├┬┘└┬┘  ║  ├─┤│  ├─┤├┤
+// ╚═╝┴┘└┘┴ ┴┴└─ ┴   ╚═╝┴ ┴└─┘┴ ┴└─┘
+
+struct BinaryHeader {
+  char magic[4]; // TR_SHADER_BINARY_MAGIC
+  GLenum format;
+  uint64_t key;
+};
+
+static bool BinaryCacheSupported(void) NOEXCEPT {
+  // GL 4.1 (ARB_get_program_binary), not guaranteed by the 3.3 context.
+  static bool const s_supported = [] {
+    if (glGetProgramBinary == NULL || glProgramBinary == NULL || glProgramParameteri == NULL) {
+      return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+  }();
+  return s_supported;
+}
+
+/// Drivers only accept their own binaries: part of the key.
+static uint64_t DriverKey(void) NOEXCEPT {
+  static uint64_t const s_key = [] {
+    static GLenum const names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    uint64_t key = TR_HASH_SEED;
+    for (GLenum name: names) {
+      char const* value = reinterpret_cast<char const*>(glGetString(name));
+      key = Hash(value != NULL ? value : "", key);
+    }
+    return key;
+  }();
+  return s_key;
+}
+
+/// Sources key extended with the driver, names the cache file.
+static uint64_t BinaryKey(uint64_t sources) NOEXCEPT {
+  return Hash(std::string_view(reinterpret_cast<char const*>(&sources), sizeof(sources)), DriverKey());
+}
+
+static std::filesystem::path BinaryPath(uint64_t key) NOEXCEPT {
+  char filename[32];
+  snprintf(filename, sizeof(filename), "%016" PRIx64 ".bin", key);
+  return std::filesystem::path(TR_BUILD_DIR "/cache/shaders") / filename;
+}
+
+bool Shader::LoadBinary(uint64_t key) NOEXCEPT {
+  if (!BinaryCacheSupported()) return false;
+
+  std::filesystem::path path = BinaryPath(key);
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  BinaryHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  bool valid = file.good()
+    && memcmp(header.magic, TR_SHADER_BINARY_MAGIC, sizeof(header.magic)) == 0
+    && header.key == key;
+
+  std::vector<char> binary;
+  if (valid) {
+    binary.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    valid = !binary.empty();
+  }
+
+  if (valid) {
+    // The link status is only checked by `Complete()`.
+    glProgramBinary(m_program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    return true;
+  }
+
+  TR_DEBUG("Corrupted program binary: %s", path.c_str());
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  return false;
+}
+
+void Shader::SaveBinary(uint64_t key) NOEXCEPT {
+  if (!BinaryCacheSupported()) return;
+
+  GLint length = 0;
+  glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) return;
+
+  BinaryHeader header = { .magic = {}, .format = 0u, .key = key };
+  memcpy(header.magic, TR_SHADER_BINARY_MAGIC, sizeof(header.magic));
+
+  std::vector<char> binary(static_cast<size_t>(length));
+  glGetProgramBinary(m_program, length, &length, &header.format, binary.data());
+
+  // Written aside then renamed: a reader never sees a partial file.
+  std::error_code error;
+  std::filesystem::path path = BinaryPath(key);
+  std::filesystem::path temporary = path; temporary += ".tmp";
+  std::filesystem::create_directories(path.parent_path(), error);
+
+  std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  file.write(binary.data(), length);
+  file.close();
+
+  if (file) {
+    std::filesystem::rename(temporary, path, error);
+  }
+  if (!file || error) {
+    TR_DEBUG("Failed to store program binary: %s", path.c_str());
+    std::filesystem::remove(temporary, error);
+  }
+}
+
+// ╦  ┬┌┐┌┬┌─
+// ║  ││││├┴┐
+// ╩═╝┴┘└┘┴ ┴
+
+void Shader::Compile(void) NOEXCEPT {
+  // Submit everything, errors are only queried by `Complete()`.
+  for (ShaderSource const& source: m_sources) {
+    GLuint shader = glCreateShader(source.type);
+    char const* data = source.source.c_str();
+    glShaderSource(shader, 1, &data, NULL);
+    glCompileShader(shader);
+    glAttachShader(m_program, shader);
+    m_stages.push_back(shader);
+  }
+
+  if (BinaryCacheSupported()) {
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   glLinkProgram(m_program);
+  m_state = STATE_SOURCE;
+}
+
+void Shader::Link(void) NOEXCEPT {
+  m_key = BinaryKey(Key(m_sources));
+  if (LoadBinary(m_key)) {
+    m_state = STATE_BINARY;
+  }
+  else {
+    Compile();
+  }
+}
 
+bool Shader::Ready(void) NOEXCEPT {
+  if (m_state == STATE_DONE) return m_status == GL_TRUE;
+  if (m_state == STATE_UNLINKED) return false;
+
+  if (s_parallel) {
+    GLint completed = GL_FALSE;
+    glGetProgramiv(m_program, TR_GL_COMPLETION_STATUS_KHR, &completed);
+    if (completed == GL_FALSE) return false;
+  }
+
+  Complete();
+  return m_status == GL_TRUE;
+}
+
+void Shader::Complete(void) NOEXCEPT {
+  GLint length;
   glGetProgramiv(m_program, GL_LINK_STATUS, &m_status);
-  if(m_status == GL_FALSE) {
-    glGetProgramiv(m_program, GL_INFO_LOG_LENGTH, &length);
-    std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
-    glGetProgramInfoLog(m_program, length, NULL, buffer.get());
-    TR_ERROR("Shader::Link Error:\n%*.*s", length, length, buffer.get());
+
+  if (m_state == STATE_BINARY) {
+    if (m_status == GL_FALSE) {
+      // Rejected by the driver: rebuilt from source, ready later.
+      TR_DEBUG("Rejected program binary: %016" PRIx64, m_key);
+      std::error_code error;
+      std::filesystem::remove(BinaryPath(m_key), error);
+      Compile();
+      return;
+    }
+  }
+  else {
+    for (GLuint shader: m_stages) {
+      GLint status, type;
+      glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+      if (status == GL_FALSE) {
+        glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
+        glGetShaderInfoLog(shader, length, NULL, buffer.get());
+        TR_ERROR("Shader::Compile(%s) Error:\n%*.*s",
+          ShaderType(static_cast<GLenum>(type)), length, length, buffer.get()
+        );
+      }
+
+      // https://gamedev.stackexchange.com/questions/47910/after-a-succesful-gllinkprogram-should-i-delete-detach-my-shaders
+      glDetachShader(m_program, shader);
+      glDeleteShader(shader);
+    }
+    m_stages.clear();
+
+    if (m_status == GL_FALSE) {
+      glGetProgramiv(m_program, GL_INFO_LOG_LENGTH, &length);
+      std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
+      glGetProgramInfoLog(m_program, length, NULL, buffer.get());
+      TR_ERROR("Shader::Link Error:\n%*.*s", length, length, buffer.get());
+    }
+    else {
+      SaveBinary(m_key);
+    }
+  }
+
+  m_sources.clear();
+  m_sources.shrink_to_fit();
+  m_state = STATE_DONE;
+  Reflect();
+}
+
+bool Shader::s_parallel = false;
+
+void Shader::EnableParallelCompile(void) NOEXCEPT {
+  s_parallel = true;
+}
+
+void Shader::Reflect(void) NOEXCEPT {
+  m_uniforms.clear();
+  if (m_status != GL_TRUE) return;
+
+  // GLSL 3.30 has no `layout (binding = N)`, link shared blocks here.
+  GLuint frameBlock = glGetUniformBlockIndex(m_program, TR_FRAME_BLOCK);
+  if (frameBlock != GL_INVALID_INDEX) {
+    glUniformBlockBinding(m_program, frameBlock, TR_FRAME_BINDING);
+  }
+
+  GLint count = 0, maxLength = 0;
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+  std::unique_ptr<char[]> name(new char[static_cast<size_t>(maxLength) + 1u]);
+
+  for (GLuint index = 0u; index < static_cast<GLuint>(count); ++index) {
+    GLint size; GLenum type; GLsizei length = 0;
+    glGetActiveUniform(m_program, index, maxLength, &length, &size, &type, name.get());
+    GLint location = glGetUniformLocation(m_program, name.get());
+    if (location == -1) continue; // Uniform block member.
+
+    // Arrays are reported as "name[0]", register them as "name" too.
+    std::string_view view(name.get(), static_cast<size_t>(length));
+    if (view.ends_with("[0]")) view.remove_suffix(3);
+    m_uniforms.emplace_back(Hash(view), location);
   }
+
+  std::sort(m_uniforms.begin(), m_uniforms.end());
+}
+
+GLint Shader::Uniform(UniformName name) NOEXCEPT {
+  if (m_state != STATE_DONE) return -1; // Not reflected yet.
+
+  auto it = std::lower_bound(
+    m_uniforms.begin(), m_uniforms.end(), name.hash,
+    [](auto const& uniform, uint64_t hash) { return uniform.first < hash; }
+  );
+
+  if (it != m_uniforms.end() && it->first == name.hash) {
+    return it->second;
+  }
+
+  // Only reported once: remembered as missing.
+  if (m_status == GL_TRUE) TR_ERROR("Missing Uniform: %s", name.name);
+  m_uniforms.emplace(it, name.hash, -1);
+  return -1;
 }
 
 TR_END_NAMESPACE()
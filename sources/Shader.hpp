@@ -6,13 +6,52 @@
 #include <glm/mat4x4.hpp> // glm::mat4{}
 #include <glm/gtc/type_ptr.hpp> // glm::value_ptr()
 
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <optional> // std::optional{}
+#include <span> // std::span{}
+#include <string> // std::string{}
 #include <string_view> // std::string_view{}
+#include <utility> // std::pair{}
+#include <vector> // std::vector{}
 
+#include "GLState.hpp" // GLState{}
 #include "helper.hpp" // NOEXCEPT
+#include "Hash.hpp" // Hash()
 #include "Log.hpp" // TR_ERROR()
 
 TR_BEGIN_NAMESPACE()
 
+///
+/// Uniform name hashed at compile-time.
+///
+/// String literals convert implicitly, so `shader.Bind("model", ...)` never
+/// hashes nor calls `glGetUniformLocation()` at runtime.
+///
+struct UniformName {
+  consteval UniformName(char const* name) NOEXCEPT
+    : hash(Hash(name)), name(name) {}
+
+  uint64_t hash;
+  char const* name;
+};
+
+///
+/// Stage source, read ahead of compilation so it can be hashed (cache key).
+///
+struct ShaderSource {
+  GLenum type;
+  std::string source;
+};
+
+///
+/// `#define NAME VALUE` injected right after `#version`.
+///
+struct ShaderDefine {
+  std::string name;
+  std::string value;
+};
+
 class Shader final {
 public:
   constexpr Shader() NOEXCEPT {
@@ -20,11 +59,12 @@ public:
   }
 
   constexpr ~Shader() NOEXCEPT {
-    glDeleteProgram(m_program);
+    GLState::DeleteProgram(m_program);
   }
 
-  constexpr void Use(void) NOEXCEPT {
-    glUseProgram(m_program);
+  /// Skipped when already in use.
+  inline void Use(void) NOEXCEPT {
+    GLState::UseProgram(m_program);
   }
 
   constexpr void Bind(GLint location, GLint value) NOEXCEPT {
@@ -52,31 +92,114 @@ public:
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
   }
 
+  /// Convenience lookup, prefer `Uniform()` handles on hot paths.
   template <typename Value>
-  constexpr void Bind(std::string_view name, Value&& value) NOEXCEPT {
+  constexpr void Bind(UniformName name, Value&& value) NOEXCEPT {
     if (m_status != GL_TRUE) return; // TODO: TMP?
-    GLint location = glGetUniformLocation(m_program, name.data());
-    if (location == -1) TR_ERROR("Missing Uniform: %s", name.data());
-    else Bind(location, std::forward<Value>(value));
+    GLint location = Uniform(name);
+    if (location != -1) Bind(location, std::forward<Value>(value));
   }
 
+  ///
+  /// Stable handle (location) of an active uniform reflected by `Link()`.
+  ///
+  /// A missing uniform is reported the first time it is requested and `-1`
+  /// (ignored by `glUniform*()`) is returned from then on.
+  ///
+  GLint Uniform(UniformName name) NOEXCEPT;
+
   constexpr GLuint Get() const NOEXCEPT {
     return m_program;
   }
 
+  /// Read from "resources/shaders/", the stage is deduced from the extension.
+  static std::optional<ShaderSource> Read(std::string_view filename) NOEXCEPT;
+
+  ///
+  /// Inject `defines` after `#version` and resolve `#include "file"` (from
+  /// "resources/shaders/", each file at most once). `#line` directives keep
+  /// the compiler errors pointing at the original line numbers.
+  ///
+  static std::string Preprocess(std::string_view source, std::span<ShaderDefine const> defines) NOEXCEPT;
+
+  /// Define for the stages attached afterwards.
+  void Define(std::string_view name, std::string_view value) NOEXCEPT;
+
+  /// Hash of the stages, types included (ResourceCache and binary cache key).
+  static uint64_t Key(std::span<ShaderSource const> sources) NOEXCEPT;
+
   /// Load from "resources/shaders/".
   void Attach(std::string_view filename) NOEXCEPT;
+
+  /// Record a preprocessed stage, only compiled by `Link()` when no cached
+  /// binary matches.
   void Attach(GLenum type, std::string_view source) NOEXCEPT;
 
+  /// Size of the attached sources (GL 3.3 cannot query the program size).
+  constexpr size_t Bytes(void) const NOEXCEPT {
+    return m_bytes;
+  }
+
+  ///
+  /// Submit the program: restored from the on-disk binary cache
+  /// ("build/cache/"), or compiled from the attached stages and linked.
+  ///
+  /// Nothing waits on the driver here, `Ready()` completes the program. The
+  /// cache key covers the sources and the driver vendor, renderer and
+  /// version: any change misses the cache. A rejected binary falls back to
+  /// compiling from source.
+  ///
   void Link(void) NOEXCEPT;
 
+  ///
+  /// Whether the program is linked and usable, uniforms included.
+  ///
+  /// With `KHR_parallel_shader_compile` this never blocks and returns false
+  /// while the driver is still compiling; otherwise the first call waits.
+  ///
+  bool Ready(void) NOEXCEPT;
+
+  /// Submitted and not completed yet: polling `Ready()` again makes progress.
+  constexpr bool Compiling(void) const NOEXCEPT {
+    return m_state == STATE_BINARY || m_state == STATE_SOURCE;
+  }
+
+  /// Set once the extension was found (and its thread count set) by Window.
+  static void EnableParallelCompile(void) NOEXCEPT;
+
 private:
   // TODO: Is there a way to increment an internal counter and retrieve it? (Like OpenCL)
   TR_DELETE_COPY_CTOR(Shader);
   TR_DELETE_MOVE_CTOR(Shader);
 
+  enum State {
+    STATE_UNLINKED = 0,
+    STATE_BINARY, // glProgramBinary() submitted
+    STATE_SOURCE, // Stages compiled and linked, status unknown
+    STATE_DONE,
+  };
+
+  void Compile(void) NOEXCEPT;
+  void Complete(void) NOEXCEPT;
+  bool LoadBinary(uint64_t key) NOEXCEPT;
+  void SaveBinary(uint64_t key) NOEXCEPT;
+  void Reflect(void) NOEXCEPT;
+
   GLuint m_program;
-  GLint m_status;
+  GLint m_status = GL_FALSE;
+  State m_state = STATE_UNLINKED;
+  uint64_t m_key = 0u; // Binary cache key
+
+  static bool s_parallel;
+  size_t m_bytes = 0u;
+
+  /// Attached stages (preprocessed), released once linked.
+  std::vector<ShaderSource> m_sources;
+  std::vector<ShaderDefine> m_defines;
+  std::vector<GLuint> m_stages; // Compiled, until the link completes
+
+  /// Sorted by hash: name hash -> location.
+  std::vector<std::pair<uint64_t, GLint>> m_uniforms;
 };
 
 TR_END_NAMESPACE()
@@ -1,47 +1,67 @@
 #include <glad/glad.h> // OpenGL Loader
-#include <stb/stb_image.h> // stbi_load()
 
-#include <string> // std::string{}
-#include <string_view> // std::string_view{}
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uintptr_t
+#include <span> // std::span{}
 
-#include "helper.hpp" // NOEXCEPT
+#include "GLState.hpp" // GLState{}
+#include "helper.hpp" // NOEXCEPT, TR_MAX()
 #include "Texture.hpp" // Self{}
-#include "Log.hpp" // TR_DEBUG()
 
 TR_BEGIN_NAMESPACE()
 
-Texture::Texture(std::string_view filename) NOEXCEPT {
+Texture::Texture(void) NOEXCEPT {
   glGenTextures(1, &m_texture);
-  glBindTexture(GL_TEXTURE_2D, m_texture);
+  GLState::BindTexture(m_texture);
 
   // Set the texture wrapping parameters.
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-  // Set texture filtering parameters.
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  // Set texture filtering parameters (every upload comes with its mipmaps).
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-  int width, height, channels;
-  stbi_set_flip_vertically_on_load(true); // Flip Y-axis.
-  std::string path = TR_RESOURCES_DIR "/textures/"; path += filename;
-  unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-
-  if (data != NULL) {
-    if (channels == 3 || channels == 4) {
-      GLint format = channels == 3 ? GL_RGB : GL_RGBA;
-      glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, (GLenum) format, GL_UNSIGNED_BYTE, data);
-      glGenerateMipmap(GL_TEXTURE_2D);
-    }
-    else {
-      TR_DEBUG("Unsupported %d-channel: %s", channels, filename.data());
-    }
-  }
-  else {
-    TR_DEBUG("Failed to load texture: %s", filename.data());
+  // Neutral grey placeholder, replaced in place once decoded.
+  static unsigned char const placeholder[] = { 0x80, 0x80, 0x80, 0xFF };
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+  m_bytes = sizeof(placeholder);
+}
+
+Texture::~Texture(void) NOEXCEPT {
+  GLState::DeleteTexture(m_texture);
+}
+
+void Texture::Upload(GLsizei width, GLsizei height, GLenum format, void const* pixels) NOEXCEPT {
+  GLState::BindTexture(m_texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB rows are not 4-byte aligned
+  glTexImage2D(GL_TEXTURE_2D, 0, (GLint) format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glGenerateMipmap(GL_TEXTURE_2D);
+
+  // Drivers pad RGB8 to 4 bytes per texel, the mip chain adds a third.
+  m_bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4u * 4u / 3u;
+  m_loaded = true;
+}
+
+void Texture::Upload(GLsizei width, GLsizei height, GLenum format, std::span<uint32_t const> levels, void const* blocks) NOEXCEPT {
+  GLState::BindTexture(m_texture);
+
+  uintptr_t offset = reinterpret_cast<uintptr_t>(blocks);
+  m_bytes = 0u;
+  for (size_t level = 0u; level < levels.size(); ++level) {
+    glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, width, height, 0,
+      static_cast<GLsizei>(levels[level]), reinterpret_cast<void const*>(offset)
+    );
+    offset += levels[level];
+    m_bytes += levels[level];
+    width = TR_MAX(width / 2, 1);
+    height = TR_MAX(height / 2, 1);
   }
 
-  stbi_image_free(data);
+  // The container may stop before 1x1.
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
+  m_loaded = true;
 }
 
 TR_END_NAMESPACE()
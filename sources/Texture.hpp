@@ -2,13 +2,29 @@
 #define TR_TEXTURE_HPP
 
 #include <glad/glad.h> // OpenGL Loader
-#include <string_view> // std::string_view{}
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <span> // std::span{}
+
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
 
 TR_BEGIN_NAMESPACE()
 
-class Texture {
+///
+/// 2D texture, holding a 1x1 placeholder until `Upload()` is called (see
+/// `TextureLoader`).
+///
+class Texture final {
 public:
-  Texture(std::string_view filename) noexcept;
+  Texture(void) noexcept;
+  ~Texture(void) noexcept;
+
+  /// Replace the storage, `pixels` may be an offset into a bound PBO.
+  void Upload(GLsizei width, GLsizei height, GLenum format, void const* pixels) NOEXCEPT;
+
+  /// Replace the storage with precompressed levels stored back to back.
+  void Upload(GLsizei width, GLsizei height, GLenum format, std::span<uint32_t const> levels, void const* blocks) NOEXCEPT;
 
   constexpr operator GLuint(void) noexcept {
     return m_texture;
@@ -18,8 +34,22 @@ public:
     return m_texture;
   }
 
+  /// Estimated video memory, mipmaps included.
+  constexpr size_t Bytes(void) const NOEXCEPT {
+    return m_bytes;
+  }
+
+  constexpr bool Loaded(void) const NOEXCEPT {
+    return m_loaded;
+  }
+
 private:
+  TR_DELETE_COPY_CTOR(Texture);
+  TR_DELETE_MOVE_CTOR(Texture);
+
   GLuint m_texture;
+  size_t m_bytes;
+  bool m_loaded = false;
 };
 
 TR_END_NAMESPACE()
@@ -0,0 +1,51 @@
+#ifndef TR_TEXTURE_FORMAT_HPP
+#define TR_TEXTURE_FORMAT_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+#include "helper.hpp" // NOEXCEPT, TR_MAX()
+
+// EXT_texture_compression_s3tc (not in the core profile loaded by glad).
+#define TR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0u // BC1
+#define TR_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3u // BC3
+
+#define TR_TEXTURE_MAGIC "TRTX"
+#define TR_TEXTURE_VERSION 1u
+#define TR_TEXTURE_EXTENSION ".trtex"
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// GPU-ready texture container written by `tools/TextureTool.cpp`.
+///
+/// The header is followed by `levels` 32-bit level sizes, then by the
+/// compressed blocks of every level back to back (largest first), ready for
+/// `glCompressedTexImage2D()`. All fields are little-endian, rows bottom-up.
+///
+struct TextureFileHeader {
+  char magic[4]; // TR_TEXTURE_MAGIC, not null-terminated
+  uint32_t version;
+  uint32_t format; // OpenGL internal format
+  uint32_t width;
+  uint32_t height;
+  uint32_t levels;
+};
+
+static_assert(sizeof(TextureFileHeader) == 24u);
+
+/// Bytes per 4x4 block.
+constexpr size_t TextureBlockBytes(uint32_t format) NOEXCEPT {
+  return format == TR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8u : 16u;
+}
+
+/// Bytes of a whole level, partial blocks included.
+constexpr size_t TextureLevelBytes(uint32_t format, uint32_t width, uint32_t height) NOEXCEPT {
+  size_t blocksX = TR_MAX((width + 3u) / 4u, 1u);
+  size_t blocksY = TR_MAX((height + 3u) / 4u, 1u);
+  return blocksX * blocksY * TextureBlockBytes(format);
+}
+
+TR_END_NAMESPACE()
+
+#endif // TR_TEXTURE_FORMAT_HPP
@@ -0,0 +1,212 @@
+#include <glad/glad.h> // OpenGL Loader
+#include <stb/stb_image.h> // stbi_load()
+
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstring> // memcpy(), memcmp(), strcmp()
+#include <fstream> // std::ifstream{}
+#include <iterator> // std::istreambuf_iterator{}
+#include <memory> // std::shared_ptr{}
+#include <mutex> // std::lock_guard{}
+#include <string> // std::string{}
+#include <string_view> // std::string_view{}
+#include <utility> // std::move()
+#include <vector> // std::vector{}
+
+#include "FrameRequest.hpp" // RequestFrame()
+#include "GLState.hpp" // GLState{}
+#include "Texture.hpp" // Texture{}
+#include "TextureFormat.hpp" // TextureFileHeader{}
+#include "TextureLoader.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT
+#include "Log.hpp" // TR_DEBUG()
+
+TR_BEGIN_NAMESPACE()
+
+void TextureLoader::PixelsDeleter::operator()(unsigned char* pixels) const NOEXCEPT {
+  stbi_image_free(pixels);
+}
+
+TextureLoader::TextureLoader(void) NOEXCEPT {
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLuint i = 0u; i < static_cast<GLuint>(count) && !m_compressed; ++i) {
+    char const* extension = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, i));
+    m_compressed = strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0;
+  }
+}
+
+/// Header, level table and level sizes are consistent with the file size.
+static bool ValidContainer(std::vector<unsigned char> const& file) NOEXCEPT {
+  TextureFileHeader header;
+  if (file.size() < sizeof(header)) return false;
+  memcpy(&header, file.data(), sizeof(header));
+
+  if (memcmp(header.magic, TR_TEXTURE_MAGIC, sizeof(header.magic)) != 0) return false;
+  if (header.version != TR_TEXTURE_VERSION) return false;
+  if (header.format != TR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+   && header.format != TR_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) return false;
+  if (header.levels == 0u || header.levels > 32u) return false;
+
+  size_t offset = sizeof(header) + header.levels * sizeof(uint32_t);
+  if (file.size() < offset) return false;
+
+  uint32_t width = header.width, height = header.height;
+  for (uint32_t level = 0u; level < header.levels; ++level) {
+    uint32_t size;
+    memcpy(&size, &file[sizeof(header) + level * sizeof(uint32_t)], sizeof(size));
+    if (size != TextureLevelBytes(header.format, width, height)) return false;
+    offset += size;
+    width = TR_MAX(width / 2u, 1u);
+    height = TR_MAX(height / 2u, 1u);
+  }
+
+  return offset == file.size();
+}
+
+void TextureLoader::Load(std::shared_ptr<Texture> texture, std::string_view filename) NOEXCEPT {
+  Image request = {
+    .texture = std::move(texture),
+    .filename = std::string(filename),
+    .requested = std::chrono::steady_clock::now(),
+    .pixels = NULL,
+    .container = {},
+    .failure = NULL,
+    .width = 0, .height = 0, .channels = 0,
+  };
+
+  m_pending += 1u;
+  m_pool.Submit([this, request = std::move(request)] mutable {
+    // Worker thread: no OpenGL.
+    if (m_compressed) {
+      std::string path = TR_BUILD_DIR "/textures/"; path += request.filename; path += TR_TEXTURE_EXTENSION;
+      std::ifstream file(path, std::ios::binary);
+      if (file) {
+        request.container.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!ValidContainer(request.container)) request.container.clear();
+      }
+
+      if (!request.container.empty()) {
+        std::lock_guard lock(m_mutex);
+        m_decoded.push_back(std::move(request));
+        RequestFrame(); // Upload it
+        return;
+      }
+    }
+
+    // Fall back to the plain image.
+    std::string path = TR_RESOURCES_DIR "/textures/"; path += request.filename;
+    stbi_set_flip_vertically_on_load_thread(true); // Flip Y-axis.
+    request.pixels.reset(stbi_load(
+      path.c_str(), &request.width, &request.height, &request.channels, 0
+    ));
+    if (request.pixels == NULL) {
+      request.failure = stbi_failure_reason();
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_decoded.push_back(std::move(request));
+    RequestFrame(); // Upload it
+  });
+}
+
+void TextureLoader::Update(double budgetMilliseconds) NOEXCEPT {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  size_t decoded;
+
+  for (;;) {
+    Image image;
+    {
+      std::lock_guard lock(m_mutex);
+      if (m_decoded.empty()) { decoded = 0u; break; }
+      image = std::move(m_decoded.front());
+      m_decoded.pop_front();
+      decoded = m_decoded.size();
+    }
+
+    Upload(image);
+    m_pending -= 1u;
+
+    std::chrono::duration<double, std::milli> latency = Clock::now() - image.requested;
+    m_stats.lastLatency = latency.count();
+    m_stats.maxLatency = TR_MAX(m_stats.maxLatency, latency.count());
+
+    std::chrono::duration<double, std::milli> spent = Clock::now() - start;
+    if (decoded == 0u || spent.count() >= budgetMilliseconds) break;
+  }
+
+  m_stats.uploading = decoded;
+  m_stats.decoding = m_pending - decoded;
+  if (decoded > 0u) RequestFrame(); // Over budget, the rest next frame
+
+  std::lock_guard lock(m_mutex);
+  m_published = m_stats;
+}
+
+void const* TextureLoader::Stage(void const* data, size_t size) NOEXCEPT {
+  if (m_PBO == 0u) {
+    glGenBuffers(1, &m_PBO);
+  }
+
+  // Orphan the previous storage, the driver copies out of the PBO
+  // asynchronously instead of blocking on client memory.
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBO);
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), NULL, GL_STREAM_DRAW);
+  void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+  );
+
+  if (mapped != NULL) {
+    memcpy(mapped, data, size);
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE) {
+      return NULL; // Offset into the bound PBO.
+    }
+  }
+
+  // Fall back to client memory when the mapping failed (or got corrupted).
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  return data;
+}
+
+void TextureLoader::Upload(Image const& image) NOEXCEPT {
+  if (!image.container.empty()) {
+    TextureFileHeader header;
+    memcpy(&header, image.container.data(), sizeof(header));
+
+    std::vector<uint32_t> sizes(header.levels);
+    memcpy(sizes.data(), &image.container[sizeof(header)], header.levels * sizeof(uint32_t));
+
+    size_t offset = sizeof(header) + header.levels * sizeof(uint32_t);
+    void const* blocks = Stage(&image.container[offset], image.container.size() - offset);
+    image.texture->Upload(
+      static_cast<GLsizei>(header.width), static_cast<GLsizei>(header.height),
+      header.format, sizes, blocks
+    );
+
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_stats.loaded += 1u;
+    return;
+  }
+
+  if (image.pixels == NULL) {
+    TR_DEBUG("Failed to load texture: %s (%s)", image.filename.c_str(), image.failure);
+    m_stats.failed += 1u;
+    return;
+  }
+
+  if (image.channels != 3 && image.channels != 4) {
+    TR_DEBUG("Unsupported %d-channel: %s", image.channels, image.filename.c_str());
+    m_stats.failed += 1u;
+    return;
+  }
+
+  GLenum format = image.channels == 3 ? GL_RGB : GL_RGBA;
+  size_t size = static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * static_cast<size_t>(image.channels);
+  void const* pixels = Stage(image.pixels.get(), size);
+  image.texture->Upload(image.width, image.height, format, pixels);
+
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  m_stats.loaded += 1u;
+}
+
+TR_END_NAMESPACE()
@@ -0,0 +1,99 @@
+#ifndef TR_TEXTURE_LOADER_HPP
+#define TR_TEXTURE_LOADER_HPP
+
+#include <chrono> // std::chrono::steady_clock{}
+#include <cstddef> // size_t
+#include <deque> // std::deque{}
+#include <memory> // std::shared_ptr{}, std::unique_ptr{}
+#include <mutex> // std::mutex{}, std::lock_guard{}
+#include <string> // std::string{}
+#include <string_view> // std::string_view{}
+#include <vector> // std::vector{}
+
+#include "Texture.hpp" // Texture{}
+#include "ThreadPool.hpp" // ThreadPool{}
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+struct TextureLoaderStats {
+  size_t decoding = 0u; // Submitted, not decoded yet
+  size_t uploading = 0u; // Decoded, waiting for the GL thread
+  size_t loaded = 0u;
+  size_t failed = 0u;
+  double lastLatency = 0.0; // Milliseconds, from `Load()` to upload
+  double maxLatency = 0.0;
+};
+
+///
+/// Decode images on a thread pool, upload them on the GL thread.
+///
+/// `Load()` only queues the request: the texture keeps whatever it holds (a
+/// placeholder) until `Update()` uploads the decoded pixels through a pixel
+/// buffer object, as many as fit in the per-frame time budget.
+///
+/// A precompressed container built by `make textures` is preferred over the
+/// image itself when the driver supports S3TC.
+///
+class TextureLoader final {
+public:
+  TextureLoader(void) NOEXCEPT;
+
+  ///
+  /// Decode `TR_RESOURCES_DIR/textures/<filename>` into `texture`.
+  ///
+  /// The texture is kept alive until uploaded, and only ever released on the
+  /// calling (GL) thread.
+  ///
+  void Load(std::shared_ptr<Texture> texture, std::string_view filename) NOEXCEPT;
+
+  /// Upload decoded images (at least one), must be called on the GL thread.
+  void Update(double budgetMilliseconds) NOEXCEPT;
+
+  /// Copy published by the last `Update()`, safe from any thread.
+  inline TextureLoaderStats Stats(void) const NOEXCEPT {
+    std::lock_guard lock(m_mutex);
+    return m_published;
+  }
+
+private:
+  TR_DELETE_COPY_CTOR(TextureLoader);
+  TR_DELETE_MOVE_CTOR(TextureLoader);
+
+  struct PixelsDeleter {
+    void operator()(unsigned char* pixels) const NOEXCEPT;
+  };
+
+  struct Image {
+    std::shared_ptr<Texture> texture;
+    std::string filename;
+    std::chrono::steady_clock::time_point requested;
+    std::unique_ptr<unsigned char, PixelsDeleter> pixels;
+    std::vector<unsigned char> container; // Whole TR_TEXTURE_EXTENSION file
+    char const* failure; // Static string from stb_image
+    int width, height, channels;
+  };
+
+  void Upload(Image const& image) NOEXCEPT;
+  void const* Stage(void const* data, size_t size) NOEXCEPT;
+
+  // GL thread only.
+  TextureLoaderStats m_stats{};
+  size_t m_pending = 0u;
+  GLuint m_PBO = 0u; // Pixel Buffer Object, created on first upload
+
+  // Read-only once constructed.
+  bool m_compressed = false; // EXT_texture_compression_s3tc
+
+  // Shared with the workers (and the UI thread for the statistics).
+  mutable std::mutex m_mutex;
+  std::deque<Image> m_decoded;
+  TextureLoaderStats m_published{};
+
+  // Last member: workers are joined before the queue above is destroyed.
+  ThreadPool m_pool{};
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_TEXTURE_LOADER_HPP
@@ -1,6 +1,5 @@
 #include "imgui/imgui.h" // ImVec4{}
 #include "ImGuiCustom.hpp" // operator+()
-#include <glad/glad.h> // glClearColor()
 
 #include "helper.hpp" // TR_VALUE_OR(), NOEXCEPT
 #include "Theme.hpp" // Self{}
@@ -129,9 +128,7 @@ void Theme::Apply(void) NOEXCEPT {
   colors[ImGuiCol_ScrollbarGrabActive]  = m_colors[ColorGrabbableActive];
   colors[ImGuiCol_ScrollbarGrabHovered] = m_colors[ColorGrabbableHovered];
 
-  // OpenGL
-  ImVec4& viewport = m_colors[ColorViewport];
-  glClearColor(viewport.x, viewport.y, viewport.z, 1.0f);
+  // OpenGL: ColorViewport is the clear color of the frame packets.
 
   ImGuiStyle& style = ImGui::GetStyle();
   style.WindowPadding                     = ImVec2(8.00f, 8.00f);
@@ -0,0 +1,54 @@
+#include <condition_variable> // std::condition_variable_any{}
+#include <cstddef> // size_t
+#include <mutex> // std::unique_lock{}
+#include <thread> // std::jthread{}, std::stop_token{}
+#include <utility> // std::move()
+
+#include "ThreadPool.hpp" // Self{}
+#include "helper.hpp" // NOEXCEPT, TR_MAX()
+
+TR_BEGIN_NAMESPACE()
+
+ThreadPool::ThreadPool(size_t threads) NOEXCEPT {
+  if (threads == 0u) {
+    size_t hardware = std::thread::hardware_concurrency();
+    threads = TR_MAX(hardware, 2u) - 1u; // Leave a core to the main thread.
+  }
+
+  m_threads.reserve(threads);
+  for (size_t i = 0u; i < threads; ++i) {
+    m_threads.emplace_back([this] (std::stop_token stop) { Work(stop); });
+  }
+}
+
+ThreadPool::~ThreadPool(void) NOEXCEPT {
+  for (std::jthread& thread: m_threads) {
+    thread.request_stop();
+  }
+  m_threads.clear(); // Join.
+}
+
+void ThreadPool::Submit(Job job) NOEXCEPT {
+  {
+    std::lock_guard lock(m_mutex);
+    m_jobs.push_back(std::move(job));
+  }
+  m_condition.notify_one();
+}
+
+void ThreadPool::Work(std::stop_token stop) NOEXCEPT {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock lock(m_mutex);
+      if (!m_condition.wait(lock, stop, [this] { return !m_jobs.empty(); })) {
+        return; // Stop requested.
+      }
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+    job();
+  }
+}
+
+TR_END_NAMESPACE()
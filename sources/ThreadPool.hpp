@@ -0,0 +1,52 @@
+#ifndef TR_THREAD_POOL_HPP
+#define TR_THREAD_POOL_HPP
+
+#include <condition_variable> // std::condition_variable{}
+#include <cstddef> // size_t
+#include <deque> // std::deque{}
+#include <functional> // std::move_only_function{}
+#include <mutex> // std::mutex{}
+#include <thread> // std::jthread{}
+#include <vector> // std::vector{}
+
+#include "helper.hpp" // NOEXCEPT, TR_DELETE_XXX_CTOR()
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Fixed set of worker threads consuming a FIFO of jobs.
+///
+/// Jobs must not touch OpenGL (there is no context on the workers): hand the
+/// results back to the main thread instead. Logging is thread-safe.
+///
+class ThreadPool final {
+public:
+  using Job = std::move_only_function<void(void)>;
+
+  /// Zero threads means `hardware_concurrency() - 1` (at least one).
+  explicit ThreadPool(size_t threads = 0u) NOEXCEPT;
+  ~ThreadPool(void) NOEXCEPT; // Pending jobs are discarded.
+
+  void Submit(Job job) NOEXCEPT;
+
+  constexpr size_t Threads(void) const NOEXCEPT {
+    return m_threads.size();
+  }
+
+private:
+  TR_DELETE_COPY_CTOR(ThreadPool);
+  TR_DELETE_MOVE_CTOR(ThreadPool);
+
+  void Work(std::stop_token stop) NOEXCEPT;
+
+  std::mutex m_mutex;
+  std::condition_variable_any m_condition;
+  std::deque<Job> m_jobs;
+
+  // Last member: the threads are joined before the queue is destroyed.
+  std::vector<std::jthread> m_threads;
+};
+
+TR_END_NAMESPACE()
+
+#endif // TR_THREAD_POOL_HPP
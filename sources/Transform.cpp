@@ -0,0 +1,333 @@
+#include <glm/mat4x4.hpp> // glm::mat4{}
+#include <glm/vec3.hpp> // glm::vec3{}
+
+#include <cmath> // sinf(), cosf(), sqrtf()
+#include <cstddef> // size_t
+#include <initializer_list> // std::initializer_list{}
+#include <vector> // std::vector{}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // SSE2, AVX2, FMA
+#define TR_TRANSFORM_X86 1
+#else
+#define TR_TRANSFORM_X86 0
+#endif
+
+#include "helper.hpp" // NOEXCEPT
+#include "Transform.hpp" // Self{}
+
+TR_BEGIN_NAMESPACE()
+
+void TransformArrays::Push(glm::vec3 position, glm::vec3 axis, float angle, float scale) NOEXCEPT {
+  x.push_back(position.x); y.push_back(position.y); z.push_back(position.z);
+  axisX.push_back(axis.x); axisY.push_back(axis.y); axisZ.push_back(axis.z);
+  this->angle.push_back(angle);
+  this->scale.push_back(scale);
+}
+
+void TransformArrays::Clear(void) NOEXCEPT {
+  x.clear(); y.clear(); z.clear();
+  axisX.clear(); axisY.clear(); axisZ.clear();
+  angle.clear();
+  scale.clear();
+}
+
+void TransformArrays::Reserve(size_t capacity) NOEXCEPT {
+  for (std::vector<float>* stream: { &x, &y, &z, &axisX, &axisY, &axisZ, &angle, &scale }) {
+    stream->reserve(capacity);
+  }
+}
+
+void TransformArrays::SwapRemove(size_t index) NOEXCEPT {
+  for (std::vector<float>* stream: { &x, &y, &z, &axisX, &axisY, &axisZ, &angle, &scale }) {
+    (*stream)[index] = stream->back();
+    stream->pop_back();
+  }
+}
+
+// ╔═╗┌─┐┌─┐┬  ┌─┐┬─┐
+// ╚═╗│  ├─┤│  ├─┤├┬┘
+// ╚═╝└─┘┴ ┴┴─┘┴ ┴┴└─
+
+static void BuildScalar(TransformStreams const& s, size_t first, glm::mat4* models) NOEXCEPT {
+  for (size_t i = first; i < s.count; ++i) {
+    float length = sqrtf(s.axisX[i] * s.axisX[i] + s.axisY[i] * s.axisY[i] + s.axisZ[i] * s.axisZ[i]);
+    float ax = s.axisX[i] / length, ay = s.axisY[i] / length, az = s.axisZ[i] / length;
+    float c = cosf(s.angle[i]), sn = sinf(s.angle[i]), k = s.scale[i];
+    float tx = (1.0f - c) * ax, ty = (1.0f - c) * ay, tz = (1.0f - c) * az;
+
+    glm::mat4& m = models[i];
+    m[0][0] = (c + tx * ax) * k;  m[0][1] = (tx * ay + sn * az) * k; m[0][2] = (tx * az - sn * ay) * k; m[0][3] = 0.0f;
+    m[1][0] = (ty * ax - sn * az) * k; m[1][1] = (c + ty * ay) * k;  m[1][2] = (ty * az + sn * ax) * k; m[1][3] = 0.0f;
+    m[2][0] = (tz * ax + sn * ay) * k; m[2][1] = (tz * ay - sn * ax) * k; m[2][2] = (c + tz * az) * k;  m[2][3] = 0.0f;
+    m[3][0] = s.x[i]; m[3][1] = s.y[i]; m[3][2] = s.z[i]; m[3][3] = 1.0f;
+  }
+}
+
+#if TR_TRANSFORM_X86
+
+// Cephes single precision sin/cos (as in sse_mathfun), accurate to ~1 ulp
+// for |x| < 8192, which is plenty for rotation angles.
+#define TR_SINCOS_FOPI   1.27323954473516f // 4 / Pi
+#define TR_SINCOS_DP1    -0.78515625f
+#define TR_SINCOS_DP2    -2.4187564849853515625e-4f
+#define TR_SINCOS_DP3    -3.77489497744594108e-8f
+#define TR_SINCOS_SIN_P0 -1.9515295891e-4f
+#define TR_SINCOS_SIN_P1 8.3321608736e-3f
+#define TR_SINCOS_SIN_P2 -1.6666654611e-1f
+#define TR_SINCOS_COS_P0 2.443315711809948e-5f
+#define TR_SINCOS_COS_P1 -1.388731625493765e-3f
+#define TR_SINCOS_COS_P2 4.166664568298827e-2f
+
+// ╔═╗╔═╗╔═╗
+// ╚═╗╚═╗║╣
+// ╚═╝╚═╝╚═╝
+
+static inline void SinCos4(__m128 x, __m128* s, __m128* c) NOEXCEPT {
+  __m128 const signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+  __m128 signSin = _mm_and_ps(x, signMask);
+  x = _mm_andnot_ps(signMask, x);
+
+  // Octant j (rounded to even) and its float value.
+  __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(TR_SINCOS_FOPI)));
+  j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+  __m128 y = _mm_cvtepi32_ps(j);
+
+  __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+  __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+    _mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29
+  ));
+  __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+  signSin = _mm_xor_ps(signSin, swapSin);
+
+  // Extended precision modular arithmetic: x = ((x - y * DP1) - y * DP2) - y * DP3.
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(TR_SINCOS_DP1)));
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(TR_SINCOS_DP2)));
+  x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(TR_SINCOS_DP3)));
+  __m128 z = _mm_mul_ps(x, x);
+
+  __m128 polyCos = _mm_set1_ps(TR_SINCOS_COS_P0);
+  polyCos = _mm_add_ps(_mm_mul_ps(polyCos, z), _mm_set1_ps(TR_SINCOS_COS_P1));
+  polyCos = _mm_add_ps(_mm_mul_ps(polyCos, z), _mm_set1_ps(TR_SINCOS_COS_P2));
+  polyCos = _mm_mul_ps(_mm_mul_ps(polyCos, z), z);
+  polyCos = _mm_sub_ps(polyCos, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+  polyCos = _mm_add_ps(polyCos, _mm_set1_ps(1.0f));
+
+  __m128 polySin = _mm_set1_ps(TR_SINCOS_SIN_P0);
+  polySin = _mm_add_ps(_mm_mul_ps(polySin, z), _mm_set1_ps(TR_SINCOS_SIN_P1));
+  polySin = _mm_add_ps(_mm_mul_ps(polySin, z), _mm_set1_ps(TR_SINCOS_SIN_P2));
+  polySin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(polySin, z), x), x);
+
+  __m128 sinValue = _mm_or_ps(_mm_and_ps(polyMask, polySin), _mm_andnot_ps(polyMask, polyCos));
+  __m128 cosValue = _mm_or_ps(_mm_and_ps(polyMask, polyCos), _mm_andnot_ps(polyMask, polySin));
+  *s = _mm_xor_ps(sinValue, signSin);
+  *c = _mm_xor_ps(cosValue, signCos);
+}
+
+static size_t BuildSSE(TransformStreams const& s, glm::mat4* models) NOEXCEPT {
+  size_t i = 0u;
+  __m128 const one = _mm_set1_ps(1.0f);
+  __m128 const zero = _mm_setzero_ps();
+
+  for (; i + 4u <= s.count; i += 4u) {
+    __m128 ax = _mm_loadu_ps(s.axisX + i);
+    __m128 ay = _mm_loadu_ps(s.axisY + i);
+    __m128 az = _mm_loadu_ps(s.axisZ + i);
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)));
+    ax = _mm_div_ps(ax, length); ay = _mm_div_ps(ay, length); az = _mm_div_ps(az, length);
+
+    __m128 sn, c, k = _mm_loadu_ps(s.scale + i);
+    SinCos4(_mm_loadu_ps(s.angle + i), &sn, &c);
+    __m128 t = _mm_sub_ps(one, c);
+    __m128 tx = _mm_mul_ps(t, ax), ty = _mm_mul_ps(t, ay), tz = _mm_mul_ps(t, az);
+    __m128 sx = _mm_mul_ps(sn, ax), sy = _mm_mul_ps(sn, ay), sz = _mm_mul_ps(sn, az);
+
+    // One register per matrix entry, one lane per object.
+    __m128 m00 = _mm_mul_ps(_mm_add_ps(c, _mm_mul_ps(tx, ax)), k);
+    __m128 m01 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(tx, ay), sz), k);
+    __m128 m02 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(tx, az), sy), k);
+    __m128 m10 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(ty, ax), sz), k);
+    __m128 m11 = _mm_mul_ps(_mm_add_ps(c, _mm_mul_ps(ty, ay)), k);
+    __m128 m12 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ty, az), sx), k);
+    __m128 m20 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(tz, ax), sy), k);
+    __m128 m21 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(tz, ay), sx), k);
+    __m128 m22 = _mm_mul_ps(_mm_add_ps(c, _mm_mul_ps(tz, az)), k);
+    __m128 m30 = _mm_loadu_ps(s.x + i);
+    __m128 m31 = _mm_loadu_ps(s.y + i);
+    __m128 m32 = _mm_loadu_ps(s.z + i);
+    __m128 m33 = one;
+
+    // SoA -> AoS: after each transpose, register N holds a column of object N.
+    __m128 m03 = zero, m13 = zero, m23 = zero;
+    _MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+    _MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+    _MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+    _MM_TRANSPOSE4_PS(m30, m31, m32, m33);
+
+    float* out = &models[i][0][0];
+    _mm_storeu_ps(out +  0, m00); _mm_storeu_ps(out +  4, m10); _mm_storeu_ps(out +  8, m20); _mm_storeu_ps(out + 12, m30);
+    _mm_storeu_ps(out + 16, m01); _mm_storeu_ps(out + 20, m11); _mm_storeu_ps(out + 24, m21); _mm_storeu_ps(out + 28, m31);
+    _mm_storeu_ps(out + 32, m02); _mm_storeu_ps(out + 36, m12); _mm_storeu_ps(out + 40, m22); _mm_storeu_ps(out + 44, m32);
+    _mm_storeu_ps(out + 48, m03); _mm_storeu_ps(out + 52, m13); _mm_storeu_ps(out + 56, m23); _mm_storeu_ps(out + 60, m33);
+  }
+
+  return i;
+}
+
+// ╔═╗╦  ╦═╗ ╦
+// ╠═╣╚╗╔╝╔╩╦╝
+// ╩ ╩ ╚╝ ╩ ╚═
+
+#define TR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+TR_TARGET_AVX2 static inline void SinCos8(__m256 x, __m256* s, __m256* c) NOEXCEPT {
+  __m256 const signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+  __m256 signSin = _mm256_and_ps(x, signMask);
+  x = _mm256_andnot_ps(signMask, x);
+
+  __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TR_SINCOS_FOPI)));
+  j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+  __m256 y = _mm256_cvtepi32_ps(j);
+
+  __m256 swapSin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29));
+  __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(
+    _mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29
+  ));
+  __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+  signSin = _mm256_xor_ps(signSin, swapSin);
+
+  x = _mm256_fmadd_ps(y, _mm256_set1_ps(TR_SINCOS_DP1), x);
+  x = _mm256_fmadd_ps(y, _mm256_set1_ps(TR_SINCOS_DP2), x);
+  x = _mm256_fmadd_ps(y, _mm256_set1_ps(TR_SINCOS_DP3), x);
+  __m256 z = _mm256_mul_ps(x, x);
+
+  __m256 polyCos = _mm256_set1_ps(TR_SINCOS_COS_P0);
+  polyCos = _mm256_fmadd_ps(polyCos, z, _mm256_set1_ps(TR_SINCOS_COS_P1));
+  polyCos = _mm256_fmadd_ps(polyCos, z, _mm256_set1_ps(TR_SINCOS_COS_P2));
+  polyCos = _mm256_mul_ps(_mm256_mul_ps(polyCos, z), z);
+  polyCos = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), polyCos);
+  polyCos = _mm256_add_ps(polyCos, _mm256_set1_ps(1.0f));
+
+  __m256 polySin = _mm256_set1_ps(TR_SINCOS_SIN_P0);
+  polySin = _mm256_fmadd_ps(polySin, z, _mm256_set1_ps(TR_SINCOS_SIN_P1));
+  polySin = _mm256_fmadd_ps(polySin, z, _mm256_set1_ps(TR_SINCOS_SIN_P2));
+  polySin = _mm256_fmadd_ps(_mm256_mul_ps(polySin, z), x, x);
+
+  *s = _mm256_xor_ps(_mm256_blendv_ps(polyCos, polySin, polyMask), signSin);
+  *c = _mm256_xor_ps(_mm256_blendv_ps(polySin, polyCos, polyMask), signCos);
+}
+
+// 4x4 transpose inside each 128-bit lane: lane 0 -> objects 0-3, lane 1 -> 4-7.
+#define TR_TRANSPOSE8x4_PS(R0, R1, R2, R3) do {  \
+    __m256 t0 = _mm256_unpacklo_ps(R0, R1);      \
+    __m256 t1 = _mm256_unpackhi_ps(R0, R1);      \
+    __m256 t2 = _mm256_unpacklo_ps(R2, R3);      \
+    __m256 t3 = _mm256_unpackhi_ps(R2, R3);      \
+    R0 = _mm256_shuffle_ps(t0, t2, 0x44);        \
+    R1 = _mm256_shuffle_ps(t0, t2, 0xEE);        \
+    R2 = _mm256_shuffle_ps(t1, t3, 0x44);        \
+    R3 = _mm256_shuffle_ps(t1, t3, 0xEE);        \
+  } while (0)
+
+TR_TARGET_AVX2 static size_t BuildAVX2(TransformStreams const& s, glm::mat4* models) NOEXCEPT {
+  size_t i = 0u;
+  __m256 const one = _mm256_set1_ps(1.0f);
+  __m256 const zero = _mm256_setzero_ps();
+
+  for (; i + 8u <= s.count; i += 8u) {
+    __m256 ax = _mm256_loadu_ps(s.axisX + i);
+    __m256 ay = _mm256_loadu_ps(s.axisY + i);
+    __m256 az = _mm256_loadu_ps(s.axisZ + i);
+    __m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(az, az, _mm256_fmadd_ps(ay, ay, _mm256_mul_ps(ax, ax))));
+    ax = _mm256_div_ps(ax, length); ay = _mm256_div_ps(ay, length); az = _mm256_div_ps(az, length);
+
+    __m256 sn, c, k = _mm256_loadu_ps(s.scale + i);
+    SinCos8(_mm256_loadu_ps(s.angle + i), &sn, &c);
+    __m256 t = _mm256_sub_ps(one, c);
+    __m256 tx = _mm256_mul_ps(t, ax), ty = _mm256_mul_ps(t, ay), tz = _mm256_mul_ps(t, az);
+    __m256 sx = _mm256_mul_ps(sn, ax), sy = _mm256_mul_ps(sn, ay), sz = _mm256_mul_ps(sn, az);
+
+    __m256 m00 = _mm256_mul_ps(_mm256_fmadd_ps(tx, ax, c), k);
+    __m256 m01 = _mm256_mul_ps(_mm256_fmadd_ps(tx, ay, sz), k);
+    __m256 m02 = _mm256_mul_ps(_mm256_fmsub_ps(tx, az, sy), k);
+    __m256 m10 = _mm256_mul_ps(_mm256_fmsub_ps(ty, ax, sz), k);
+    __m256 m11 = _mm256_mul_ps(_mm256_fmadd_ps(ty, ay, c), k);
+    __m256 m12 = _mm256_mul_ps(_mm256_fmadd_ps(ty, az, sx), k);
+    __m256 m20 = _mm256_mul_ps(_mm256_fmadd_ps(tz, ax, sy), k);
+    __m256 m21 = _mm256_mul_ps(_mm256_fmsub_ps(tz, ay, sx), k);
+    __m256 m22 = _mm256_mul_ps(_mm256_fmadd_ps(tz, az, c), k);
+    __m256 m30 = _mm256_loadu_ps(s.x + i);
+    __m256 m31 = _mm256_loadu_ps(s.y + i);
+    __m256 m32 = _mm256_loadu_ps(s.z + i);
+    __m256 m33 = one;
+
+    __m256 m03 = zero, m13 = zero, m23 = zero;
+    TR_TRANSPOSE8x4_PS(m00, m01, m02, m03);
+    TR_TRANSPOSE8x4_PS(m10, m11, m12, m13);
+    TR_TRANSPOSE8x4_PS(m20, m21, m22, m23);
+    TR_TRANSPOSE8x4_PS(m30, m31, m32, m33);
+
+    // Columns (0, 1) and (2, 3) of object N and N+4 share a register pair.
+    __m256 columns[4][4] = {
+      { m00, m10, m20, m30 }, { m01, m11, m21, m31 },
+      { m02, m12, m22, m32 }, { m03, m13, m23, m33 },
+    };
+    for (size_t n = 0u; n < 4u; ++n) {
+      float* low = &models[i + n][0][0];
+      float* high = &models[i + n + 4u][0][0];
+      _mm256_storeu_ps(low + 0, _mm256_permute2f128_ps(columns[n][0], columns[n][1], 0x20));
+      _mm256_storeu_ps(low + 8, _mm256_permute2f128_ps(columns[n][2], columns[n][3], 0x20));
+      _mm256_storeu_ps(high + 0, _mm256_permute2f128_ps(columns[n][0], columns[n][1], 0x31));
+      _mm256_storeu_ps(high + 8, _mm256_permute2f128_ps(columns[n][2], columns[n][3], 0x31));
+    }
+  }
+
+  return i;
+}
+
+#endif // TR_TRANSFORM_X86
+
+// ╔╦╗┬┌─┐┌─┐┌─┐┌┬┐┌─┐┬ ┬
+//  ║║│└─┐├─┘├─┤ │ │  ├─┤
+// ═╩╝┴└─┘┴  ┴ ┴ ┴ └─┘┴ ┴
+
+TransformKernel TransformKernelDetect(void) NOEXCEPT {
+#if TR_TRANSFORM_X86
+  static TransformKernel s_kernel = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+    ? TransformKernel::AVX2 : TransformKernel::SSE;
+  return s_kernel;
+#else
+  return TransformKernel::Scalar;
+#endif
+}
+
+char const* TransformKernelName(TransformKernel kernel) NOEXCEPT {
+  switch (kernel) {
+    case TransformKernel::Scalar: return "Scalar";
+    case TransformKernel::SSE:    return "SSE2";
+    case TransformKernel::AVX2:   return "AVX2";
+    default:                      return "??";
+  }
+}
+
+void BuildModelMatrices(TransformStreams const& streams, glm::mat4* models) NOEXCEPT {
+  BuildModelMatrices(streams, models, TransformKernelDetect());
+}
+
+void BuildModelMatrices(TransformStreams const& streams, glm::mat4* models, TransformKernel kernel) NOEXCEPT {
+  size_t done = 0u;
+
+#if TR_TRANSFORM_X86
+  if (kernel == TransformKernel::AVX2 && TransformKernelDetect() == TransformKernel::AVX2) {
+    done = BuildAVX2(streams, models);
+  }
+  else if (kernel != TransformKernel::Scalar) {
+    done = BuildSSE(streams, models);
+  }
+#endif
+
+  // Remainder (and fallback).
+  BuildScalar(streams, done, models);
+}
+
+TR_END_NAMESPACE()
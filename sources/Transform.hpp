@@ -0,0 +1,83 @@
+#ifndef TR_TRANSFORM_HPP
+#define TR_TRANSFORM_HPP
+
+#include <glm/mat4x4.hpp> // glm::mat4{}
+#include <glm/vec3.hpp> // glm::vec3{}
+
+#include <cstddef> // size_t
+#include <vector> // std::vector{}
+
+#include "helper.hpp" // NOEXCEPT
+
+TR_BEGIN_NAMESPACE()
+
+///
+/// Structure-of-arrays view over object transforms, one entry per object.
+///
+/// The rotation axis does not need to be normalised, angles are in radians.
+///
+struct TransformStreams {
+  float const* x;
+  float const* y;
+  float const* z;
+  float const* axisX;
+  float const* axisY;
+  float const* axisZ;
+  float const* angle;
+  float const* scale;
+  size_t count;
+};
+
+///
+/// Owning storage for `TransformStreams`.
+///
+struct TransformArrays {
+  std::vector<float> x, y, z;
+  std::vector<float> axisX, axisY, axisZ;
+  std::vector<float> angle;
+  std::vector<float> scale;
+
+  void Push(glm::vec3 position, glm::vec3 axis, float angle, float scale) NOEXCEPT;
+  void Clear(void) NOEXCEPT;
+  void Reserve(size_t capacity) NOEXCEPT;
+
+  /// O(1) removal: the last entry is moved into `index`.
+  void SwapRemove(size_t index) NOEXCEPT;
+
+  constexpr size_t Size(void) const NOEXCEPT {
+    return x.size();
+  }
+
+  constexpr TransformStreams Streams(void) const NOEXCEPT {
+    return {
+      x.data(), y.data(), z.data(),
+      axisX.data(), axisY.data(), axisZ.data(),
+      angle.data(), scale.data(),
+      x.size()
+    };
+  }
+};
+
+enum class TransformKernel {
+  Scalar,
+  SSE, // SSE2, 4 objects per iteration
+  AVX2, // AVX2 + FMA, 8 objects per iteration
+};
+
+/// Best kernel supported by the running CPU.
+TransformKernel TransformKernelDetect(void) NOEXCEPT;
+char const* TransformKernelName(TransformKernel kernel) NOEXCEPT;
+
+///
+/// Write `model = translate(position) * rotate(angle, axis) * scale(scale)`
+/// for every object, exactly like the `glm::translate()` + `glm::rotate()`
+/// path (up to float rounding).
+///
+/// @pre `models` holds at least `streams.count` matrices.
+///
+void BuildModelMatrices(TransformStreams const& streams, glm::mat4* models) NOEXCEPT;
+void BuildModelMatrices(TransformStreams const& streams, glm::mat4* models, TransformKernel kernel) NOEXCEPT;
+
+TR_END_NAMESPACE()
+
+#endif // TR_TRANSFORM_HPP
@@ -8,19 +8,27 @@
 #include <GLFW/glfw3.h> // GLFW Library
 
 #include <optional> // std::optional{}, std::nullopt
-#include <utility> // std::in_place
+#include <utility> // std::in_place, std::swap()
 
 #include "Event.hpp" // Event{}
+#include "FrameRequest.hpp" // RequestFrame(), ConsumeFrameRequest()
+#include "GLState.hpp" // GLState{}, GLStateStats{}
+#include "InputQueue.hpp" // InputQueue{}, InputEvent{}
+#include "Profiler.hpp" // Profiler::Zone{}
+#include "RenderThread.hpp" // RenderThread{}, FramePacket{}
+#include "Shader.hpp" // Shader::EnableParallelCompile()
 #include "Window.hpp" // Window{}
 #include "Log.hpp" // TR_ERROR(), GlobalLog(), GlobalLogRender()
 #include "helper.hpp" // NOEXCEPT
 
 #define TR_TITLE "[OpenGL] First Project"
+#define TR_IDLE_TIMEOUT 1.0 // Seconds between two frames when idle (on demand)
+#define TR_SETTLE_FRAMES 3u // Frames drawn after input (ImGui hover, layout)
 
 TR_BEGIN_NAMESPACE()
 
 static void ErrorCallback(int error, const char* description) {
-  GlobalLog(stderr, "GLFW Error %d: %s\n", error, description);
+  GlobalLog(LogLevel::ERROR, "GLFW Error %d: %s\n", error, description);
 }
 
 void Window::KeyboardCallback(GLFWwindow* window, int key, int scancode, int action, int mods) NOEXCEPT {
@@ -39,6 +47,9 @@ void Window::KeyboardCallback(GLFWwindow* window, int key, int scancode, int act
   if (source->m_navigationMode && key == GLFW_KEY_H && action == GLFW_PRESS) {
     source->ToggleWireframeMode();
   }
+
+  // Always recorded: the key table must be right when navigation starts.
+  source->m_input.PushKey(key, action);
 }
 
 void Window::MouseCallback(GLFWwindow* window, double x, double y) NOEXCEPT {
@@ -47,13 +58,7 @@ void Window::MouseCallback(GLFWwindow* window, double x, double y) NOEXCEPT {
   if (source == NULL) return;
 
   if (source->m_navigationMode) {
-    MouseEvent event;
-    // TODO: Current/Elapsed per event.
-    double currentTime = glfwGetTime();
-    event.currentTime = currentTime,
-    event.elapsedTime = currentTime - source->m_currentTime,
-    event.x = x; event.y = y;
-    source->m_engine.ProcessMouse(event);
+    source->m_input.PushMouse(x, y);
   }
 }
 
@@ -63,21 +68,26 @@ void Window::ScrollCallback(GLFWwindow* window, double x, double y) NOEXCEPT {
   if (source == NULL) return;
 
   if (source->m_navigationMode) {
-    ScrollEvent event;
-    // TODO: Current/Elapsed per event.
-    double currentTime = glfwGetTime();
-    event.currentTime = currentTime,
-    event.elapsedTime = currentTime - source->m_currentTime,
-    event.xOffset = x; event.yOffset = y;
-    source->m_engine.ProcessScroll(event);
+    source->m_input.PushScroll(x, y);
   }
 }
 
-std::optional<Window> Window::Create(void) NOEXCEPT {
+GLFWwindow* Window::CreateContext(int width, int height, bool visible) NOEXCEPT {
   glfwSetErrorCallback(ErrorCallback);
-  if (glfwInit() == GLFW_FALSE) {
+  bool initialised = glfwInit() == GLFW_TRUE;
+
+  #ifdef GLFW_PLATFORM_NULL // GLFW 3.4
+  // No display (CI, render servers): the null platform renders with OSMesa.
+  if (!initialised && !visible) {
+    TR_WARNING("No display, falling back to the GLFW null platform.");
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    initialised = glfwInit() == GLFW_TRUE;
+  }
+  #endif
+
+  if (!initialised) {
     TR_ERROR("GLFW initialisation failed.");
-    return std::nullopt;
+    return NULL;
   }
 
   #define TR_GLSL_VERSION "#version 330"
@@ -85,48 +95,83 @@ std::optional<Window> Window::Create(void) NOEXCEPT {
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // #if __APPLE__ ?
-  glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+  glfwWindowHint(GLFW_MAXIMIZED, visible ? GLFW_TRUE : GLFW_FALSE);
+  glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
-  GLFWwindow* window = glfwCreateWindow(1280, 720, TR_TITLE, NULL, NULL);
+  #ifdef GLFW_PLATFORM_NULL
+  if (glfwGetPlatform() == GLFW_PLATFORM_NULL) {
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+  }
+  #endif
+
+  GLFWwindow* window = glfwCreateWindow(width, height, TR_TITLE, NULL, NULL);
   if (window == NULL) {
     TR_ERROR("GLFW window creation failed.");
     glfwTerminate();
-    return std::nullopt;
+    return NULL;
   }
 
   TR_DEBUG("GLFW initialised.");
-  glfwMaximizeWindow(window);
   glfwMakeContextCurrent(window);
-  // TODO: What is vertical synchronization?
-  // glfwSwapInterval(1);
+  // Swap interval: see `FramePacer{}`.
 
   if (!gladLoadGLLoader((GLADloadproc) glfwGetProcAddress)) {
     TR_ERROR("GLAD initialisation failed.");
+    glfwDestroyWindow(window);
     glfwTerminate();
-    return std::nullopt;
+    return NULL;
   }
 
   TR_DEBUG("GLAD initialised.");
-  glEnable(GL_BLEND);
+  GLState::Reset(); // New context
+  GLState::Enable(GL_BLEND);
   // FinalColor = FragColor.rgb * FragColor.a + FrameBuffer.rgb * (1 - FragColor.a)
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_DEPTH_TEST);
+  GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  GLState::Enable(GL_DEPTH_TEST);
   TR_DEBUG(
     "OpenGL Version %d.%d"
     , GLVersion.major
     , GLVersion.minor
   );
 
+  // Not part of the glad loader, the KHR and ARB variants are identical.
+  using MaxShaderCompilerThreads = void (APIENTRYP)(GLuint count);
+  static struct { char const* extension; char const* function; } const parallelCompile[] = {
+    { "GL_KHR_parallel_shader_compile", "glMaxShaderCompilerThreadsKHR" },
+    { "GL_ARB_parallel_shader_compile", "glMaxShaderCompilerThreadsARB" },
+  };
+
+  for (auto const& [extension, function]: parallelCompile) {
+    if (!glfwExtensionSupported(extension)) continue;
+    auto maxShaderCompilerThreads = (MaxShaderCompilerThreads) glfwGetProcAddress(function);
+    if (maxShaderCompilerThreads != NULL) {
+      maxShaderCompilerThreads(0xFFFFFFFFu); // Let the driver decide.
+      Shader::EnableParallelCompile();
+      TR_DEBUG("Parallel shader compilation: %s", extension);
+      break;
+    }
+  }
+
+  return window;
+}
+
+std::optional<Window> Window::Create(void) NOEXCEPT {
+  GLFWwindow* window = CreateContext(1280, 720, true);
+  if (window == NULL) return std::nullopt;
+
+  glfwMaximizeWindow(window);
   return std::optional<Window>(std::in_place, window);
 }
 
 Window::Window(GLFWwindow* window) NOEXCEPT
-  : m_window(window), m_dockSpaceId(0), m_engine(), m_theme()
+  : m_window(window), m_dockSpaceId(0), m_input(), m_engine(), m_theme(), m_profiler(), m_pacer()
+  , m_engineFrame(), m_renderer([this] (FramePacket const& packet) { RenderFrame(packet); })
 {
   glfwSetWindowUserPointer(window, this);
   glfwSetKeyCallback(window, KeyboardCallback);
   glfwSetCursorPosCallback(window, MouseCallback);
   glfwSetScrollCallback(window, ScrollCallback);
+  m_pacer.SetMode(PacingMode::VSync);
 
   float xscale = 0.5, yscale = 0; // TODO: TMP
   glfwGetWindowContentScale(window, &xscale, &yscale);
@@ -153,6 +198,7 @@ Window::Window(GLFWwindow* window) NOEXCEPT
 }
 
 Window::~Window(void) NOEXCEPT {
+  m_renderer.Stop(); // The context is current here again.
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplGlfw_Shutdown();
   ImGui::DestroyContext();
@@ -166,7 +212,19 @@ Window::~Window(void) NOEXCEPT {
 bool Window::MainLoop(void) NOEXCEPT {
   TR_DEBUG("Start MainLoop.");
   while (!glfwWindowShouldClose(m_window)) {
-    double currentTime = glfwGetTime();
+    // Between frames, no packet is being filled.
+    if (m_renderThread && !m_renderer.Running()) {
+      m_profiler.SetGpu(false);
+      m_renderer.Start(m_window);
+    }
+    else if (!m_renderThread && m_renderer.Running()) {
+      m_renderer.Stop();
+      m_profiler.SetGpu(true);
+    }
+
+    if (m_onDemand) WaitForFrame();
+
+    double currentTime = m_input.Now();
     m_elapsedTime = currentTime - m_currentTime;
     m_currentTime = currentTime;
 
@@ -175,26 +233,42 @@ bool Window::MainLoop(void) NOEXCEPT {
       continue;
     }
 
-    ProcessInput();
+    m_profiler.BeginFrame();
+    { Profiler::Zone zone(m_profiler, "ProcessInput"); ProcessInput(); }
 
-    ImGui_ImplOpenGL3_NewFrame();
+    // Only creates the device objects (first frame, on the GL thread).
+    if (!m_renderer.Running()) ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    RenderUi();
-    RenderEngine();
-    ImGui::Render();
-
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    glfwSwapBuffers(m_window);
+    { Profiler::Zone zone(m_profiler, "RenderUi"); RenderUi(); }
+    if (ImGui::GetIO().WantTextInput) RequestFrame(); // Blinking cursor
+    { Profiler::Zone zone(m_profiler, "UpdateEngine"); UpdateEngine(); }
+    { Profiler::Zone zone(m_profiler, "ImGui::Render"); ImGui::Render(); }
+    { Profiler::Zone zone(m_profiler, "SubmitFrame"); SubmitFrame(); }
+    { Profiler::Zone zone(m_profiler, "FramePacer::Wait"); m_pacer.Wait(); }
+    m_profiler.EndFrame();
     glfwPollEvents();
   }
 
   return true;
 }
 
+void Window::WaitForFrame(void) NOEXCEPT {
+  // Navigation polls the keyboard every frame.
+  if (m_navigationMode || ConsumeFrameRequest()) return;
+
+  // Nothing to draw: the last presented frame stays on screen. Woken up by
+  // input, `RequestFrame()` (glfwPostEmptyEvent()) or the timeout, which
+  // refreshes the panels fed without requests (logs, statistics).
+  double start = glfwGetTime();
+  glfwWaitEventsTimeout(TR_IDLE_TIMEOUT);
+  double end = glfwGetTime();
+
+  if (end - start < TR_IDLE_TIMEOUT) RequestFrame(TR_SETTLE_FRAMES);
+  m_currentTime = m_input.Now(); // Waiting is not elapsed time (animations, camera).
+}
+
 void Window::ToggleNavigationMode(bool enter) NOEXCEPT {
   if (enter && !m_navigationMode) {
     ImGui::SetWindowFocus(NULL);
@@ -217,28 +291,98 @@ void Window::ToggleNavigationMode(bool enter) NOEXCEPT {
 }
 
 void Window::ToggleWireframeMode(void) NOEXCEPT {
-  // GLint polygonMode[2]; // .[1] = GL_FILL | GL_LINE | GL_POINT
-  // glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+  m_wireframeMode = !m_wireframeMode; // Applied by `RenderFrame()`
+}
+
+void Window::SubmitFrame(void) NOEXCEPT {
+  FramePacket* packet;
+  { Profiler::Zone zone(m_profiler, "RenderThread::Acquire"); packet = &m_renderer.Acquire(); }
 
-  m_wireframeMode = !m_wireframeMode;
-  // GL_FRONT_AND_BACK: apply it to the front and back of all triangles.
-  glPolygonMode(GL_FRONT_AND_BACK, m_wireframeMode ? GL_LINE : GL_FILL);
+  // The packet gets the prepared frame, its old buffers are reused next.
+  std::swap(packet->engine, m_engineFrame);
+  for (int i = 0; i < 4; ++i) packet->viewport[i] = m_viewport[i];
+  packet->clearColor = m_theme.Get(Theme::ColorViewport);
+  packet->wireframe = m_wireframeMode;
+  packet->swapInterval = m_pacer.SwapInterval();
+
+  // The next ImGui frame starts while the render thread draws this one.
+  ImDrawData* drawData = ImGui::GetDrawData();
+  packet->drawData = m_renderer.Running() ? packet->CopyDrawData(*drawData) : drawData;
+
+  m_renderer.Submit();
+}
+
+void Window::RenderFrame(FramePacket const& packet) NOEXCEPT {
+  if (packet.swapInterval != m_swapInterval) {
+    glfwSwapInterval(packet.swapInterval);
+    m_swapInterval = packet.swapInterval;
+  }
+
+  // Front and back of all triangles, skipped when unchanged.
+  GLState::PolygonMode(packet.wireframe ? GL_LINE : GL_FILL);
+
+  glClearColor(packet.clearColor.x, packet.clearColor.y, packet.clearColor.z, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glViewport(packet.viewport[0], packet.viewport[1], packet.viewport[2], packet.viewport[3]);
+
+  // Zones are ignored on the render thread (the profiler is main thread only).
+  { Profiler::Zone zone(m_profiler, "Engine::Submit", true); m_engine.Submit(packet.engine); }
+  {
+    Profiler::Zone zone(m_profiler, "ImGui_ImplOpenGL3_RenderDrawData", true);
+    ImGui_ImplOpenGL3_RenderDrawData(packet.drawData);
+  }
+  { Profiler::Zone zone(m_profiler, "glfwSwapBuffers"); glfwSwapBuffers(m_window); }
+  GLState::EndFrame();
 }
 
 void Window::ProcessInput(void) NOEXCEPT {
-  if (m_navigationMode) {
+  // Movement is integrated piecewise between the events: a key held for
+  // part of the frame moves the camera for that part only, in the direction
+  // the mouse had turned it to at that time.
+  double time = m_currentTime - m_elapsedTime; // Previous frame
+  auto move = [&](double until) {
+    until = TR_CLAMP(until, time, m_currentTime);
+    if (!m_navigationMode || until <= time) return;
+
     KeyboardEvent event;
-    // TODO: Current/Elapsed per event.
-    event.currentTime = m_currentTime;
-    event.elapsedTime = m_elapsedTime;
-    event.keyA = glfwGetKey(m_window, GLFW_KEY_A) == GLFW_PRESS;
-    event.keyD = glfwGetKey(m_window, GLFW_KEY_D) == GLFW_PRESS;
-    event.keyS = glfwGetKey(m_window, GLFW_KEY_S) == GLFW_PRESS;
-    event.keyW = glfwGetKey(m_window, GLFW_KEY_W) == GLFW_PRESS;
-    event.shift = glfwGetKey(m_window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS;
-    event.space = glfwGetKey(m_window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    event.currentTime = until;
+    event.elapsedTime = until - time;
+    event.keyA = m_input.Pressed(GLFW_KEY_A);
+    event.keyD = m_input.Pressed(GLFW_KEY_D);
+    event.keyS = m_input.Pressed(GLFW_KEY_S);
+    event.keyW = m_input.Pressed(GLFW_KEY_W);
+    event.shift = m_input.Pressed(GLFW_KEY_LEFT_SHIFT);
+    event.space = m_input.Pressed(GLFW_KEY_SPACE);
     m_engine.ProcessKeyboard(event);
-  }
+    time = until;
+  };
+
+  m_input.Drain([&](InputEvent const& input) {
+    double inputTime = m_input.Seconds(input.ticks);
+    move(inputTime);
+
+    switch (input.type) {
+      case InputType::Key: break; // Pressed() changes after this call.
+      case InputType::Mouse: {
+        MouseEvent event;
+        event.currentTime = inputTime;
+        event.elapsedTime = inputTime - time;
+        event.x = input.x; event.y = input.y;
+        m_engine.ProcessMouse(event);
+        break;
+      }
+      case InputType::Scroll: {
+        ScrollEvent event;
+        event.currentTime = inputTime;
+        event.elapsedTime = inputTime - time;
+        event.xOffset = input.x; event.yOffset = input.y;
+        m_engine.ProcessScroll(event);
+        break;
+      }
+    }
+  });
+
+  move(m_currentTime);
 }
 
 void Window::RenderUi(void) NOEXCEPT {
@@ -247,6 +391,7 @@ void Window::RenderUi(void) NOEXCEPT {
   static char const* s_propertiesTitle = "Properties";
   static char const* s_themeTitle = "Theme";
   static char const* s_logTitle = "Logs";
+  static char const* s_profilerTitle = "Profiler";
 
   ImGuiDockNodeFlags dockSpaceFlags = (0
     | ImGuiDockNodeFlags_NoDockingInCentralNode
@@ -305,6 +450,7 @@ void Window::RenderUi(void) NOEXCEPT {
       ImGui::DockBuilderSplitNode(leftId, ImGuiDir_Up, 0.7f, &topId, &bottomId); // T\B
       ImGui::DockBuilderDockWindow(s_sceneTitle, sceneId);
       ImGui::DockBuilderDockWindow(s_logTitle, logId);
+      ImGui::DockBuilderDockWindow(s_profilerTitle, logId);
       ImGui::DockBuilderDockWindow(s_themeTitle, topId);
       ImGui::DockBuilderDockWindow(s_propertiesTitle, topId);
       ImGui::DockBuilderDockWindow(s_inspectorTitle, bottomId);
@@ -327,6 +473,7 @@ void Window::RenderUi(void) NOEXCEPT {
   DrawProperties(s_propertiesTitle);
   DrawTheme(s_themeTitle);
   DrawLogs(s_logTitle);
+  DrawProfiler(s_profilerTitle);
 
   if (m_demoOpen) ImGui::ShowDemoWindow(&m_demoOpen);
   if (m_styleOpen) {
@@ -355,7 +502,7 @@ void Window::DrawMenuBar(void) NOEXCEPT {
     if (ImGui::BeginMenu("View")) {
       // TODO: Implement actual full screen.
       if (ImGui::MenuItem("Full Screen")) {
-        m_themeOpen = m_propertiesOpen = m_inspectorOpen = m_logOpen = false;
+        m_themeOpen = m_propertiesOpen = m_inspectorOpen = m_logOpen = m_profilerOpen = false;
         m_demoOpen = m_styleOpen = false;
       }
 
@@ -364,6 +511,7 @@ void Window::DrawMenuBar(void) NOEXCEPT {
       ImGui::MenuItem("Properties", NULL, &m_propertiesOpen);
       ImGui::MenuItem("Inspector", NULL, &m_inspectorOpen);
       ImGui::MenuItem("Logs", NULL, &m_logOpen);
+      ImGui::MenuItem("Profiler", NULL, &m_profilerOpen);
       ImGui::SeparatorText("ImGui");
       ImGui::MenuItem("Demo Window", NULL, &m_demoOpen);
       ImGui::MenuItem("Style Editor", NULL, &m_styleOpen);
@@ -434,6 +582,41 @@ void Window::DrawInspector(char const* title) NOEXCEPT {
       1000.0f / io.Framerate, io.Framerate
     );
 
+    CullingStats const& culling = m_engine.Culling();
+    ImGui::Text(
+      "Culling %zu / %zu visible (%.3f ms)",
+      culling.visible, culling.tested, culling.milliseconds
+    );
+
+    DrawQueueStats draws = m_engine.Draws();
+    GLStateStats state = GLState::Stats();
+    ImGui::Text(
+      "Draws %zu (sort %.3f ms), %llu GL state calls (%llu skipped)",
+      draws.items, draws.milliseconds,
+      static_cast<unsigned long long>(state.issued), static_cast<unsigned long long>(state.skipped)
+    );
+
+    TextureLoaderStats textures = m_engine.Textures();
+    ImGui::Text(
+      "Textures %zu decoding, %zu uploading (%.1f ms latency, max %.1f ms)",
+      textures.decoding, textures.uploading, textures.lastLatency, textures.maxLatency
+    );
+
+    ImGui::SeparatorText("Frame Pacing");
+    m_pacer.RenderUi();
+    ImGui::Checkbox("Render On Demand", &m_onDemand);
+    ImGui::SetItemTooltip("Only redraw on input, animations, loads and compiles.");
+
+    ImGui::SeparatorText("Render Thread");
+    ImGui::Checkbox("Render Thread", &m_renderThread);
+    ImGui::SetItemTooltip("Draw and present on a thread owning the context, the next frame is prepared meanwhile.");
+    int frames = static_cast<int>(m_renderer.FramesInFlight());
+    if (ImGui::SliderInt("Frames In Flight", &frames, 1, static_cast<int>(TR_FRAMES_IN_FLIGHT))) {
+      m_renderer.SetFramesInFlight(static_cast<uint32_t>(frames));
+    }
+    ImGui::Text("Submission %.2f ms/frame", m_renderer.Milliseconds());
+    ImGui::Separator();
+
     bool wireframeMode = m_wireframeMode;
     if (ImGui::Checkbox("Wireframe", &wireframeMode)) {
       ToggleWireframeMode();
@@ -455,6 +638,7 @@ void Window::DrawTheme(char const* title) NOEXCEPT {
   if (ImGui::Begin(title, &m_themeOpen)) {
     if (m_theme.RenderEdit()) {
       m_theme.Apply(); m_engine.OnThemeUpdate(m_theme);
+      RequestFrame(); // The engine draws with the new colors next frame
     }
   }
   ImGui::End();
@@ -465,29 +649,37 @@ void Window::DrawLogs(char const* title) NOEXCEPT {
   GlobalLogRender(title, &m_logOpen);
 }
 
-void Window::RenderEngine(void) NOEXCEPT {
-  GLint width, height, frameWidth, frameHeight;
+void Window::DrawProfiler(char const* title) NOEXCEPT {
+  if (!m_profilerOpen) return;
+  if (ImGui::Begin(title, &m_profilerOpen)) {
+    m_profiler.RenderUi();
+  }
+  ImGui::End();
+}
+
+void Window::UpdateEngine(void) NOEXCEPT {
+  GLint frameWidth, frameHeight;
   ImGuiDockNode* node = ImGui::DockBuilderGetCentralNode(m_dockSpaceId);
   glfwGetFramebufferSize(m_window, &frameWidth, &frameHeight);
 
   if (node == NULL) {
-    width = frameWidth; height = frameHeight;
-    glViewport(0, 0, frameWidth, frameHeight);
-    m_engine.SetViewport(frameWidth, frameHeight);
+    m_viewport[0] = 0; m_viewport[1] = 0;
+    m_viewport[2] = frameWidth; m_viewport[3] = frameHeight;
   }
   else {
-    width = static_cast<GLint>(node->Size.x);
-    height = static_cast<GLint>(node->Size.y);
+    GLint width = static_cast<GLint>(node->Size.x);
+    GLint height = static_cast<GLint>(node->Size.y);
     GLint x = static_cast<GLint>(node->Pos.x);
     GLint y = static_cast<GLint>(node->Pos.y);
-    glViewport(x, frameHeight - (y + height) , width, height);
-    m_engine.SetViewport(width, height);
+    m_viewport[0] = x; m_viewport[1] = frameHeight - (y + height);
+    m_viewport[2] = width; m_viewport[3] = height;
   }
 
-  m_engine.Render({
+  m_engine.SetViewport(m_viewport[2], m_viewport[3]);
+  m_engine.Update({
     .currentTime = m_currentTime,
     .elapsedTime = m_elapsedTime,
-  });
+  }, m_engineFrame);
 }
 
 TR_END_NAMESPACE()
@@ -5,11 +5,16 @@
 #include <GLFW/glfw3.h> // GLFW Library
 #include "imgui/imgui.h" // ImGuiID
 
+#include <climits> // INT_MIN
 #include <optional> // std::optional{}
 #include <utility> // std::in_place
 
 #include "Theme.hpp" // Theme{}
 #include "Engine.hpp" // Engine{}
+#include "FramePacer.hpp" // FramePacer{}
+#include "InputQueue.hpp" // InputQueue{}
+#include "Profiler.hpp" // Profiler{}
+#include "RenderThread.hpp" // RenderThread{}, FramePacket{}
 #include "helper.hpp" // TR_DELETE_XXX_CTOR()
 
 TR_BEGIN_NAMESPACE()
@@ -22,6 +27,13 @@ class Window final {
 public:
   static std::optional<Window> Create(void) NOEXCEPT;
 
+  ///
+  /// Initialise GLFW and create a window with a current OpenGL 3.3 core
+  /// context (loaded by GLAD), NULL on failure. `visible` false gives an
+  /// offscreen context, see `Headless{}`.
+  ///
+  static GLFWwindow* CreateContext(int width, int height, bool visible) NOEXCEPT;
+
   static void MouseCallback(GLFWwindow*, double, double) NOEXCEPT;
   static void ScrollCallback(GLFWwindow*, double, double) NOEXCEPT;
   static void KeyboardCallback(GLFWwindow*, int, int, int, int) NOEXCEPT;
@@ -34,7 +46,7 @@ public:
   void ProcessInput(void) NOEXCEPT;
 
   void RenderUi(void) NOEXCEPT;
-  void RenderEngine(void) NOEXCEPT;
+  void UpdateEngine(void) NOEXCEPT;
 
 private:
   void DrawMenuBar(void) NOEXCEPT;
@@ -43,6 +55,7 @@ private:
   void DrawProperties(char const* title) NOEXCEPT;
   void DrawTheme(char const* title) NOEXCEPT;
   void DrawLogs(char const* title) NOEXCEPT;
+  void DrawProfiler(char const* title) NOEXCEPT;
 
 private:
   TR_DELETE_COPY_CTOR(Window);
@@ -50,24 +63,42 @@ private:
 
   void ToggleNavigationMode(bool enter) NOEXCEPT;
   void ToggleWireframeMode(void) NOEXCEPT;
+  void WaitForFrame(void) NOEXCEPT;
+  void SubmitFrame(void) NOEXCEPT;
+  void RenderFrame(FramePacket const& packet) NOEXCEPT; // GL thread
 
   double m_currentTime = 0.0;
   double m_elapsedTime = 0.0;
 
   bool m_navigationMode = false;
   bool m_wireframeMode = false;
+  bool m_onDemand = false; // Render only when something changed
+  bool m_renderThread = false; // Submit the frames from `m_renderer`
 
   bool m_inspectorOpen = true;
   bool m_propertiesOpen = true;
   bool m_themeOpen = true;
   bool m_logOpen = true;
+  bool m_profilerOpen = true;
   bool m_styleOpen = false;
   bool m_demoOpen = false;
 
   GLFWwindow* m_window;
   ImGuiID m_dockSpaceId;
+  InputQueue m_input;
   Engine m_engine;
   Theme m_theme;
+  Profiler m_profiler;
+  FramePacer m_pacer;
+
+  EngineFrame m_engineFrame; // Prepared, swapped into the next packet
+  GLint m_viewport[4] = {}; // Scene (central node)
+
+  // Swap interval applied by `RenderFrame()`.
+  int m_swapInterval = INT_MIN;
+
+  // Last member: stopped before the rest is destroyed.
+  RenderThread m_renderer;
 };
 
 TR_END_NAMESPACE()
@@ -1,11 +1,66 @@
-#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <cstdint> // uint32_t
+#include <cstdio> // fprintf(), sscanf()
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE, strtoul()
+#include <cstring> // strcmp()
 #include <optional> // std::optional{}
 
+#include "Headless.hpp" // Headless{}, HeadlessOptions{}
 #include "Window.hpp"
+#include "Log.hpp" // GlobalLogFlush()
 #include "helper.hpp" // TR
 
-int main(void) {
-  auto window = TR::Window::Create();
-  return window && window->MainLoop()
-    ? EXIT_SUCCESS : EXIT_FAILURE;
+static int Usage(char const* program) {
+  fprintf(stderr,
+    "Usage: %s [--bench [--frames N] [--warmup N] [--size WxH] [--output PATH|-]]\n"
+    , program
+  );
+  return EXIT_FAILURE;
+}
+
+///
+/// `--bench` renders offscreen without ImGui and writes JSON statistics
+/// (`build/bench/results.json` by default), for CI and render servers.
+///
+int main(int argc, char* argv[]) {
+  bool bench = false;
+  TR::HeadlessOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    char const* argument = argv[i];
+    char const* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+    if (strcmp(argument, "--bench") == 0) {
+      bench = true;
+    }
+    else if (strcmp(argument, "--frames") == 0 && value != NULL) {
+      options.frames = static_cast<uint32_t>(strtoul(value, NULL, 10)); ++i;
+    }
+    else if (strcmp(argument, "--warmup") == 0 && value != NULL) {
+      options.warmup = static_cast<uint32_t>(strtoul(value, NULL, 10)); ++i;
+    }
+    else if (strcmp(argument, "--size") == 0 && value != NULL) {
+      if (sscanf(value, "%dx%d", &options.width, &options.height) != 2) return Usage(argv[0]);
+      if (options.width <= 0 || options.height <= 0) return Usage(argv[0]);
+      ++i;
+    }
+    else if (strcmp(argument, "--output") == 0 && value != NULL) {
+      options.output = value; ++i;
+    }
+    else {
+      return Usage(argv[0]);
+    }
+  }
+
+  bool success = false;
+  if (bench) {
+    auto headless = TR::Headless::Create(options);
+    success = headless && headless->Run();
+  }
+  else {
+    auto window = TR::Window::Create();
+    success = window && window->MainLoop();
+  }
+
+  TR::GlobalLogFlush();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,283 @@
+#include <stb/stb_image.h> // stbi_load()
+
+#include <cstdint> // uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstdio> // fprintf(), fopen()
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring> // memcpy()
+#include <vector> // std::vector{}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h> // SSE2
+#define TR_TOOL_SSE2 1
+#else
+#define TR_TOOL_SSE2 0
+#endif
+
+#include "TextureFormat.hpp" // TextureFileHeader{}
+#include "helper.hpp" // TR_MIN(), TR_MAX()
+
+///
+/// Offline converter: image -> `.trtex` container (BC1 or BC3, full mip chain).
+///
+///   texturetool <input.png|jpg> <output.trtex>
+///
+/// Images with any transparent texel are encoded as BC3, otherwise BC1.
+///
+
+TR_BEGIN_NAMESPACE()
+
+struct Image {
+  uint32_t width;
+  uint32_t height;
+  std::vector<uint8_t> rgba; // 4 bytes per texel, rows bottom-up
+};
+
+// ╔╦╗┬┌─┐┌┬┐┌─┐┌─┐┌─┐
+// ║║║│├─┘│││├─┤├─┘└─┐
+// ╩ ╩┴┴  ┴ ┴┴ ┴┴  └─┘
+
+/// 2x2 box filter, the last row/column is repeated on odd sizes.
+static Image Downsample(Image const& source) NOEXCEPT {
+  Image target;
+  target.width = TR_MAX(source.width / 2u, 1u);
+  target.height = TR_MAX(source.height / 2u, 1u);
+  target.rgba.resize(size_t(target.width) * target.height * 4u);
+
+  for (uint32_t y = 0u; y < target.height; ++y) {
+    uint8_t const* row0 = &source.rgba[size_t(TR_MIN(2u * y, source.height - 1u)) * source.width * 4u];
+    uint8_t const* row1 = &source.rgba[size_t(TR_MIN(2u * y + 1u, source.height - 1u)) * source.width * 4u];
+    uint8_t* out = &target.rgba[size_t(y) * target.width * 4u];
+    uint32_t x = 0u;
+
+#if TR_TOOL_SSE2
+    // 4 output texels from 2x8 input texels, when the columns pair up.
+    if (source.width % 2u == 0u) {
+      __m128i const zero = _mm_setzero_si128();
+      __m128i const two = _mm_set1_epi16(2);
+
+      for (; x + 4u <= target.width; x += 4u) {
+        __m128 a0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(row0 + 8u * x)));
+        __m128 b0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(row0 + 8u * x + 16u)));
+        __m128 a1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(row1 + 8u * x)));
+        __m128 b1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(row1 + 8u * x + 16u)));
+
+        // Split even/odd texels (32-bit lanes) so each lane holds a 2x2 quad.
+        __m128i even0 = _mm_castps_si128(_mm_shuffle_ps(a0, b0, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i odd0  = _mm_castps_si128(_mm_shuffle_ps(a0, b0, _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128i even1 = _mm_castps_si128(_mm_shuffle_ps(a1, b1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i odd1  = _mm_castps_si128(_mm_shuffle_ps(a1, b1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        // Sum in 16 bits, round, divide by 4.
+        __m128i low = _mm_add_epi16(
+          _mm_add_epi16(_mm_unpacklo_epi8(even0, zero), _mm_unpacklo_epi8(odd0, zero)),
+          _mm_add_epi16(_mm_unpacklo_epi8(even1, zero), _mm_unpacklo_epi8(odd1, zero))
+        );
+        __m128i high = _mm_add_epi16(
+          _mm_add_epi16(_mm_unpackhi_epi8(even0, zero), _mm_unpackhi_epi8(odd0, zero)),
+          _mm_add_epi16(_mm_unpackhi_epi8(even1, zero), _mm_unpackhi_epi8(odd1, zero))
+        );
+        low = _mm_srli_epi16(_mm_add_epi16(low, two), 2);
+        high = _mm_srli_epi16(_mm_add_epi16(high, two), 2);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4u * x), _mm_packus_epi16(low, high));
+      }
+    }
+#endif
+
+    for (; x < target.width; ++x) {
+      uint32_t x0 = TR_MIN(2u * x, source.width - 1u);
+      uint32_t x1 = TR_MIN(2u * x + 1u, source.width - 1u);
+      for (uint32_t c = 0u; c < 4u; ++c) {
+        uint32_t sum = row0[4u * x0 + c] + row0[4u * x1 + c] + row1[4u * x0 + c] + row1[4u * x1 + c];
+        out[4u * x + c] = static_cast<uint8_t>((sum + 2u) / 4u);
+      }
+    }
+  }
+
+  return target;
+}
+
+// ╔╗ ┬  ┌─┐┌─┐┬┌─┌─┐
+// ╠╩╗│  │ ││  ├┴┐└─┐
+// ╚═╝┴─┘└─┘└─┘┴ ┴└─┘
+
+static uint16_t To565(uint8_t const color[3]) NOEXCEPT {
+  return static_cast<uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+static void From565(uint16_t value, int color[3]) NOEXCEPT {
+  int r = (value >> 11) & 0x1F, g = (value >> 5) & 0x3F, b = value & 0x1F;
+  color[0] = (r << 3) | (r >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (b << 3) | (b >> 2);
+}
+
+/// BC1 color block: inset bounding box endpoints, nearest palette entry.
+static void EncodeColor(uint8_t const texels[16][4], uint8_t* out) NOEXCEPT {
+  uint8_t low[3] = { 255u, 255u, 255u }, high[3] = { 0u, 0u, 0u };
+  for (int i = 0; i < 16; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      low[c] = TR_MIN(low[c], texels[i][c]);
+      high[c] = TR_MAX(high[c], texels[i][c]);
+    }
+  }
+
+  // Pull the endpoints in by 1/16th of the range: less error on average.
+  for (int c = 0; c < 3; ++c) {
+    uint8_t inset = static_cast<uint8_t>((high[c] - low[c]) >> 4);
+    low[c] = static_cast<uint8_t>(low[c] + inset);
+    high[c] = static_cast<uint8_t>(high[c] - inset);
+  }
+
+  // color0 > color1 selects the 4-color mode (the only one in BC3).
+  uint16_t color0 = To565(high), color1 = To565(low);
+  if (color0 < color1) { uint16_t swap = color0; color0 = color1; color1 = swap; }
+
+  int palette[4][3];
+  From565(color0, palette[0]);
+  From565(color1, palette[1]);
+  for (int c = 0; c < 3; ++c) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  uint32_t indices = 0u;
+  if (color0 != color1) {
+    for (int i = 0; i < 16; ++i) {
+      int best = 0, bestDistance = INT32_MAX;
+      for (int p = 0; p < 4; ++p) {
+        int dr = texels[i][0] - palette[p][0];
+        int dg = texels[i][1] - palette[p][1];
+        int db = texels[i][2] - palette[p][2];
+        int distance = dr * dr + dg * dg + db * db;
+        if (distance < bestDistance) { bestDistance = distance; best = p; }
+      }
+      indices |= static_cast<uint32_t>(best) << (2 * i);
+    }
+  }
+
+  out[0] = static_cast<uint8_t>(color0); out[1] = static_cast<uint8_t>(color0 >> 8);
+  out[2] = static_cast<uint8_t>(color1); out[3] = static_cast<uint8_t>(color1 >> 8);
+  for (int i = 0; i < 4; ++i) out[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+/// BC3 alpha block: min/max endpoints, 8-value interpolation mode.
+static void EncodeAlpha(uint8_t const texels[16][4], uint8_t* out) NOEXCEPT {
+  int alpha0 = 0, alpha1 = 255;
+  for (int i = 0; i < 16; ++i) {
+    alpha0 = TR_MAX(alpha0, int(texels[i][3]));
+    alpha1 = TR_MIN(alpha1, int(texels[i][3]));
+  }
+
+  int palette[8] = { alpha0, alpha1 };
+  for (int p = 1; p < 7; ++p) {
+    palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+  }
+
+  uint64_t indices = 0u;
+  if (alpha0 != alpha1) {
+    for (int i = 0; i < 16; ++i) {
+      int best = 0, bestDistance = INT32_MAX;
+      for (int p = 0; p < 8; ++p) {
+        int distance = texels[i][3] > palette[p] ? texels[i][3] - palette[p] : palette[p] - texels[i][3];
+        if (distance < bestDistance) { bestDistance = distance; best = p; }
+      }
+      indices |= static_cast<uint64_t>(best) << (3 * i);
+    }
+  }
+
+  out[0] = static_cast<uint8_t>(alpha0);
+  out[1] = static_cast<uint8_t>(alpha1);
+  for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+/// Append the blocks of a whole level, edges are clamped on partial blocks.
+static void Compress(Image const& image, uint32_t format, std::vector<uint8_t>& out) NOEXCEPT {
+  for (uint32_t by = 0u; by < image.height; by += 4u) {
+    for (uint32_t bx = 0u; bx < image.width; bx += 4u) {
+      uint8_t texels[16][4];
+      for (uint32_t i = 0u; i < 16u; ++i) {
+        uint32_t x = TR_MIN(bx + i % 4u, image.width - 1u);
+        uint32_t y = TR_MIN(by + i / 4u, image.height - 1u);
+        memcpy(texels[i], &image.rgba[(size_t(y) * image.width + x) * 4u], 4u);
+      }
+
+      size_t offset = out.size();
+      out.resize(offset + TextureBlockBytes(format));
+      if (format == TR_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) {
+        EncodeAlpha(texels, &out[offset]);
+        offset += 8u;
+      }
+      EncodeColor(texels, &out[offset]);
+    }
+  }
+}
+
+TR_END_NAMESPACE()
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s <input> <output" TR_TEXTURE_EXTENSION ">\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Same orientation as the runtime stb_image path.
+  int width, height, channels;
+  stbi_set_flip_vertically_on_load(true);
+  unsigned char* data = stbi_load(argv[1], &width, &height, &channels, 4);
+  if (data == NULL) {
+    fprintf(stderr, "%s: %s\n", argv[1], stbi_failure_reason());
+    return EXIT_FAILURE;
+  }
+
+  TR::Image image = {
+    .width = static_cast<uint32_t>(width),
+    .height = static_cast<uint32_t>(height),
+    .rgba = std::vector<uint8_t>(data, data + size_t(width) * size_t(height) * 4u),
+  };
+  stbi_image_free(data);
+
+  bool opaque = true;
+  for (size_t i = 3u; i < image.rgba.size() && opaque; i += 4u) {
+    opaque = image.rgba[i] == 255u;
+  }
+
+  TR::TextureFileHeader header = {
+    .magic = { TR_TEXTURE_MAGIC[0], TR_TEXTURE_MAGIC[1], TR_TEXTURE_MAGIC[2], TR_TEXTURE_MAGIC[3] },
+    .version = TR_TEXTURE_VERSION,
+    .format = opaque ? TR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT : TR_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+    .width = image.width,
+    .height = image.height,
+    .levels = 0u,
+  };
+
+  std::vector<uint32_t> sizes;
+  std::vector<uint8_t> blocks;
+  for (;;) {
+    size_t before = blocks.size();
+    TR::Compress(image, header.format, blocks);
+    sizes.push_back(static_cast<uint32_t>(blocks.size() - before));
+    if (image.width == 1u && image.height == 1u) break;
+    image = TR::Downsample(image);
+  }
+  header.levels = static_cast<uint32_t>(sizes.size());
+
+  FILE* file = fopen(argv[2], "wb");
+  if (file == NULL) {
+    perror(argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  bool written = fwrite(&header, sizeof(header), 1u, file) == 1u
+    && fwrite(sizes.data(), sizeof(uint32_t), sizes.size(), file) == sizes.size()
+    && fwrite(blocks.data(), 1u, blocks.size(), file) == blocks.size();
+  if (fclose(file) != 0 || !written) {
+    perror(argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  printf("%s: %dx%d %s, %u levels, %zu bytes\n", argv[2], width, height,
+    opaque ? "BC1" : "BC3", header.levels, blocks.size()
+  );
+  return EXIT_SUCCESS;
+}